@@ -0,0 +1,108 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    Benchmark.cpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Reporting of darkness_bench results.
+
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace Darkness::Benchmark {
+    namespace {
+        struct Result final
+        {
+            std::string name;
+            std::size_t threadsCount;
+            std::vector<std::pair<char const*, double>> metrics;
+        };
+
+        std::FILE* tableOutput = stdout;
+
+        std::vector<Result>& GetResults()
+        {
+            static std::vector<Result> results;
+            return results;
+        }
+
+        double Percentile(std::vector<double> const& sorted, double fraction)
+        {
+            auto const index = static_cast<std::size_t>(std::ceil(fraction * double(sorted.size()))) - 1;
+            return sorted[std::min(index, sorted.size() - 1)];
+        }
+    } /// end unnamed namespace
+
+    void SetTableOutput(std::FILE* file) noexcept
+    {
+        tableOutput = file;
+    }
+
+    std::FILE* GetTableOutput() noexcept
+    {
+        return tableOutput;
+    }
+
+    void Report(std::string const& name, std::size_t threadsCount, std::size_t operationsCount
+                , tClock::duration elapsed)
+    {
+        double const nanoseconds = std::chrono::duration<double, std::nano>(elapsed).count();
+        double const nanosecondsPerOperation = nanoseconds / double(operationsCount);
+        double const operationsPerSecond = double(operationsCount) * 1e9 / nanoseconds;
+        std::fprintf(tableOutput, "%-40s threads=%-3zu ops=%-10zu %10.1f ns/op %12.0f ops/s\n", name.c_str()
+                     , threadsCount, operationsCount, nanosecondsPerOperation, operationsPerSecond);
+
+        GetResults().push_back({ name, threadsCount, { { "ops", double(operationsCount) }
+                                                       , { "ns_per_op", nanosecondsPerOperation }
+                                                       , { "ops_per_s", operationsPerSecond } } });
+    }
+
+    void ReportPercentiles(std::string const& name, std::size_t threadsCount, std::vector<double>& nanoseconds)
+    {
+        if (nanoseconds.empty())
+        {
+            std::fprintf(tableOutput, "%-40s threads=%-3zu no samples\n", name.c_str(), threadsCount);
+            return;
+        }
+
+        std::sort(nanoseconds.begin(), nanoseconds.end());
+        Result result { name, threadsCount, { { "samples", double(nanoseconds.size()) }
+                                              , { "min_ns", nanoseconds.front() }
+                                              , { "p50_ns", Percentile(nanoseconds, 0.5) }
+                                              , { "p90_ns", Percentile(nanoseconds, 0.9) }
+                                              , { "p99_ns", Percentile(nanoseconds, 0.99) }
+                                              , { "p999_ns", Percentile(nanoseconds, 0.999) }
+                                              , { "max_ns", nanoseconds.back() } } };
+
+        std::fprintf(tableOutput, "%-40s threads=%-3zu n=%-8zu p50=%.0f p90=%.0f p99=%.0f p99.9=%.0f max=%.0f ns\n"
+                     , name.c_str(), threadsCount, nanoseconds.size(), result.metrics[2].second
+                     , result.metrics[3].second, result.metrics[4].second, result.metrics[5].second
+                     , result.metrics[6].second);
+
+        GetResults().push_back(std::move(result));
+    }
+
+    void WriteJson(std::FILE* file)
+    {
+        std::fprintf(file, "{\n  \"hardware_threads\": %u,\n  \"results\": [", std::thread::hardware_concurrency());
+        bool isFirst = true;
+        for (auto const& result : GetResults())
+        {
+            std::fprintf(file, "%s\n    {\"name\": \"%s\", \"threads\": %zu", isFirst ? "" : ",", result.name.c_str()
+                         , result.threadsCount);
+            for (auto const& [key, value] : result.metrics)
+            {
+                std::fprintf(file, ", \"%s\": %.3f", key, value);
+            }
+
+            std::fprintf(file, "}");
+            isFirst = false;
+        }
+
+        std::fprintf(file, "\n  ]\n}\n");
+    }
+} /// end namespace Darkness::Benchmark
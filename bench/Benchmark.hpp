@@ -0,0 +1,69 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    Benchmark.hpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Common helpers of darkness_bench.
+
+#pragma once
+
+#include <barrier>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Darkness::Benchmark {
+    using tClock = std::chrono::steady_clock;
+
+    /// @brief Runs body(threadIndex) on threadsCount threads which are released at once.
+    /// @return The wall time from the release till the end of the slowest thread.
+    template<typename BodyT>
+    [[nodiscard]] tClock::duration RunOnThreads(std::size_t threadsCount, BodyT&& body)
+    {
+        std::barrier start(static_cast<std::ptrdiff_t>(threadsCount + 1));
+        std::vector<std::jthread> threads;
+        threads.reserve(threadsCount);
+        for (std::size_t index = 0; index < threadsCount; ++index)
+        {
+            threads.emplace_back([&start, &body, index] {
+                start.arrive_and_wait();
+                body(index);
+            });
+        }
+
+        start.arrive_and_wait();
+        auto const begin = tClock::now();
+        threads.clear();
+        return tClock::now() - begin;
+    }
+
+    /// @brief Redirects the human-readable table, stdout by default.
+    void SetTableOutput(std::FILE* file) noexcept;
+
+    [[nodiscard]] std::FILE* GetTableOutput() noexcept;
+
+    /// @brief Prints and records a throughput result.
+    void Report(std::string const& name, std::size_t threadsCount, std::size_t operationsCount
+                , tClock::duration elapsed);
+
+    /// @brief Prints and records the latency distribution of the samples. The samples are sorted in place.
+    void ReportPercentiles(std::string const& name, std::size_t threadsCount, std::vector<double>& nanoseconds);
+
+    /// @brief Writes all recorded results as JSON.
+    void WriteJson(std::FILE* file);
+
+    void RunQueueBenchmarks();
+
+    void RunEventBenchmarks();
+
+    void RunSpinlockBenchmarks();
+
+    void RunTimerBenchmarks();
+
+    void RunSchedulerBenchmarks();
+} /// end namespace Darkness::Benchmark
@@ -0,0 +1,52 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    EventBenchmark.cpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Round-trip benchmarks of Event.
+
+#include "Benchmark.hpp"
+
+#include <Darkness/Concurrency/Event.hpp>
+
+namespace Darkness::Benchmark {
+    namespace {
+        constexpr std::size_t const _RoundTrips = 20'000;
+
+        /// @short The main thread sets ping and waits for pong, the partner thread answers.
+        template<typename EventT>
+        void _RunPingPong(std::string const& name)
+        {
+            EventT ping;
+            EventT pong;
+            std::vector<double> samples;
+            samples.reserve(_RoundTrips);
+
+            std::jthread partner([&] {
+                for (std::size_t i = 0; i < _RoundTrips; ++i)
+                {
+                    (void) ping.Wait(true);
+                    pong.Set();
+                }
+            });
+
+            for (std::size_t i = 0; i < _RoundTrips; ++i)
+            {
+                auto const begin = tClock::now();
+                ping.Set();
+                (void) pong.Wait(true);
+                samples.push_back(std::chrono::duration<double, std::nano>(tClock::now() - begin).count());
+            }
+
+            ReportPercentiles(name, 2, samples);
+        }
+    } /// end unnamed namespace
+
+    void RunEventBenchmarks()
+    {
+        _RunPingPong<Concurrency::tEvent>("event.ping_pong.condition_variable");
+        _RunPingPong<Concurrency::tAtomicEvent>("event.ping_pong.atomic_wait");
+    }
+} /// end namespace Darkness::Benchmark
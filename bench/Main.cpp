@@ -0,0 +1,107 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    Main.cpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Entry point of darkness_bench.
+///          @short Usage: darkness_bench [--json <file>] [group...]
+///                 The groups are queue, event, lock, timer and scheduler, all of them run by default.
+///                 With --json the results are also written as JSON into the file. With "-" the JSON is written
+///                 to stdout and the table goes to stderr, so stdout stays parseable.
+
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <string_view>
+#include <thread>
+
+namespace {
+    constexpr std::array<std::string_view, 5> const Groups { "queue", "event", "lock", "timer", "scheduler" };
+} /// end unnamed namespace
+
+int main(int argc, char** argv)
+{
+    char const* jsonPath = nullptr;
+    std::vector<std::string_view> groups;
+    for (int index = 1; index < argc; ++index)
+    {
+        if (std::strcmp(argv[index], "--json") == 0 && index + 1 < argc)
+        {
+            jsonPath = argv[++index];
+        }
+        else
+        {
+            groups.emplace_back(argv[index]);
+        }
+    }
+
+    for (std::string_view const group : groups)
+    {
+        if (std::find(Groups.begin(), Groups.end(), group) == Groups.end())
+        {
+            std::fprintf(stderr, "Unknown group %.*s. The groups are queue, event, lock, timer and scheduler.\n"
+                         , static_cast<int>(group.size()), group.data());
+            return 1;
+        }
+    }
+
+    auto const isSelected = [&groups](std::string_view group) {
+        return groups.empty() || std::find(groups.begin(), groups.end(), group) != groups.end();
+    };
+
+    bool const isJsonToStdout = jsonPath && std::strcmp(jsonPath, "-") == 0;
+    if (isJsonToStdout)
+    {
+        Darkness::Benchmark::SetTableOutput(stderr);
+    }
+
+    std::fprintf(Darkness::Benchmark::GetTableOutput(), "darkness_bench, hardware threads: %u\n"
+                 , std::thread::hardware_concurrency());
+
+    if (isSelected("queue"))
+    {
+        Darkness::Benchmark::RunQueueBenchmarks();
+    }
+
+    if (isSelected("event"))
+    {
+        Darkness::Benchmark::RunEventBenchmarks();
+    }
+
+    if (isSelected("lock"))
+    {
+        Darkness::Benchmark::RunSpinlockBenchmarks();
+    }
+
+    if (isSelected("timer"))
+    {
+        Darkness::Benchmark::RunTimerBenchmarks();
+    }
+
+    if (isSelected("scheduler"))
+    {
+        Darkness::Benchmark::RunSchedulerBenchmarks();
+    }
+
+    if (jsonPath)
+    {
+        std::FILE* const file = isJsonToStdout ? stdout : std::fopen(jsonPath, "w");
+        if (!file)
+        {
+            std::fprintf(stderr, "Can not open %s\n", jsonPath);
+            return 1;
+        }
+
+        Darkness::Benchmark::WriteJson(file);
+        if (!isJsonToStdout)
+        {
+            std::fclose(file);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,139 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    QueueBenchmark.cpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Throughput and latency benchmarks of Queue.
+
+#include "Benchmark.hpp"
+
+#include <Darkness/Concurrency/Event.hpp>
+#include <Darkness/Concurrency/QueueManager.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace Darkness::Benchmark {
+    namespace {
+        constexpr std::size_t const _PostsPerRun = 1'000'000;
+        constexpr std::size_t const _BatchSize = 64;
+        constexpr std::size_t const _IdleSamples = 10'000;
+        constexpr std::size_t const _BurstsCount = 100;
+        constexpr std::size_t const _BurstSize = 1'000;
+
+        constexpr std::string_view const _QueueName = "Darkness.Benchmark.Queue";
+
+        void _WaitFor(std::atomic<std::size_t> const& executed, std::size_t count)
+        {
+            while (executed.load(std::memory_order_acquire) < count)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        /// @short The time is counted from the release of the producers till the last task is executed.
+        void _RunPostThroughput(Concurrency::IQueue& queue, std::size_t producersCount)
+        {
+            std::atomic<std::size_t> executed { 0 };
+            std::size_t const postsPerProducer = _PostsPerRun / producersCount;
+
+            auto const producing = RunOnThreads(producersCount, [&](std::size_t) {
+                for (std::size_t i = 0; i < postsPerProducer; ++i)
+                {
+                    queue.Post([&executed] { executed.fetch_add(1, std::memory_order_release); });
+                }
+            });
+
+            auto const producersEnd = tClock::now();
+            _WaitFor(executed, postsPerProducer * producersCount);
+            Report("queue.post", producersCount, postsPerProducer * producersCount
+                   , producing + (tClock::now() - producersEnd));
+        }
+
+        void _RunPostBatchThroughput(Concurrency::IQueue& queue)
+        {
+            std::atomic<std::size_t> executed { 0 };
+            std::size_t const batchesCount = _PostsPerRun / _BatchSize;
+
+            auto const producing = RunOnThreads(1, [&](std::size_t) {
+                std::vector<Concurrency::tTask> batch(_BatchSize);
+                for (std::size_t i = 0; i < batchesCount; ++i)
+                {
+                    for (auto& task : batch)
+                    {
+                        task = [&executed] { executed.fetch_add(1, std::memory_order_release); };
+                    }
+
+                    queue.PostBatch(batch);
+                }
+            });
+
+            auto const producersEnd = tClock::now();
+            _WaitFor(executed, batchesCount * _BatchSize);
+            Report("queue.post_batch.64", 1, batchesCount * _BatchSize, producing + (tClock::now() - producersEnd));
+        }
+
+        /// @short One task at a time, the queue worker is idle when the task is posted.
+        void _RunIdleLatency(Concurrency::IQueue& queue)
+        {
+            Concurrency::tAtomicEvent executed;
+            std::vector<double> samples;
+            samples.reserve(_IdleSamples);
+
+            for (std::size_t i = 0; i < _IdleSamples; ++i)
+            {
+                auto const posted = tClock::now();
+                queue.Post([&samples, &executed, posted] {
+                    samples.push_back(std::chrono::duration<double, std::nano>(tClock::now() - posted).count());
+                    executed.Set();
+                });
+
+                (void) executed.Wait(true);
+            }
+
+            ReportPercentiles("queue.latency.idle", 1, samples);
+        }
+
+        /// @short Bursts of tasks, the latency includes the time in the queue behind the previous tasks.
+        void _RunBurstLatency(Concurrency::IQueue& queue)
+        {
+            std::atomic<std::size_t> executed { 0 };
+            std::vector<double> samples;
+            samples.reserve(_BurstsCount * _BurstSize);
+
+            for (std::size_t burst = 0; burst < _BurstsCount; ++burst)
+            {
+                for (std::size_t i = 0; i < _BurstSize; ++i)
+                {
+                    queue.Post([&samples, &executed, posted = tClock::now()] {
+                        samples.push_back(std::chrono::duration<double, std::nano>(tClock::now() - posted).count());
+                        executed.fetch_add(1, std::memory_order_release);
+                    });
+                }
+
+                _WaitFor(executed, (burst + 1) * _BurstSize);
+            }
+
+            ReportPercentiles("queue.latency.burst.1000", 1, samples);
+        }
+    } /// end unnamed namespace
+
+    void RunQueueBenchmarks()
+    {
+        auto const queue = Concurrency::QueueManager::Instance().CreateOrGetBackgroundQueueByName(_QueueName).lock();
+        queue->Start();
+
+        for (std::size_t const producersCount : { 1, 2, 4, 8 })
+        {
+            _RunPostThroughput(*queue, producersCount);
+        }
+
+        _RunPostBatchThroughput(*queue);
+        _RunIdleLatency(*queue);
+        _RunBurstLatency(*queue);
+
+        Concurrency::QueueManager::Instance().ForgetByName(_QueueName);
+    }
+} /// end namespace Darkness::Benchmark
@@ -0,0 +1,81 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    SchedulerBenchmark.cpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Resume cost benchmarks of the coroutine schedulers.
+
+#include "Benchmark.hpp"
+
+#include <Darkness/Concurrency/Coroutine/ConcurrentPriorityQueueScheduler.hpp>
+#include <Darkness/Concurrency/Coroutine/DeadlineScheduler.hpp>
+#include <Darkness/Concurrency/Coroutine/PriorityQueueScheduler.hpp>
+
+#include <algorithm>
+
+namespace Darkness::Benchmark {
+    namespace {
+        constexpr std::size_t const _Suspensions = 4;
+        constexpr std::size_t const _LevelsCount = 256;
+
+        using tDecrement = decltype([](int priority) { return priority - 1; });
+
+        Concurrency::Coroutine::Task<> _Work()
+        {
+            for (std::size_t i = 0; i < _Suspensions; ++i)
+            {
+                co_await std::suspend_always();
+            }
+        }
+
+        /// @short Each coroutine is resumed _Suspensions + 1 times, one resume is one operation.
+        template<typename SchedulerT, typename... ArgsT>
+        void _RunResume(std::string const& name, std::size_t coroutinesCount, std::size_t threadsCount
+                        , ArgsT&&... arguments)
+        {
+            SchedulerT scheduler(std::forward<ArgsT>(arguments)...);
+            for (std::size_t i = 0; i < coroutinesCount; ++i)
+            {
+                scheduler.AddTask(static_cast<int>(i % _LevelsCount), _Work().release());
+            }
+
+            auto const begin = tClock::now();
+            scheduler.Schedule();
+            Report(name, threadsCount, coroutinesCount * (_Suspensions + 1), tClock::now() - begin);
+        }
+
+        void _RunDeadlineResume(std::size_t coroutinesCount)
+        {
+            Concurrency::Coroutine::DeadlineScheduler<> scheduler;
+            auto const now = tClock::now();
+            for (std::size_t i = 0; i < coroutinesCount; ++i)
+            {
+                scheduler.AddTask(now + std::chrono::microseconds(i % _LevelsCount), _Work().release());
+            }
+
+            auto const begin = tClock::now();
+            scheduler.Schedule();
+            Report("scheduler.resume.deadline." + std::to_string(coroutinesCount), 1
+                   , coroutinesCount * (_Suspensions + 1), tClock::now() - begin);
+        }
+    } /// end unnamed namespace
+
+    void RunSchedulerBenchmarks()
+    {
+        using namespace Concurrency::Coroutine;
+
+        std::size_t const workersCount = std::max(std::thread::hardware_concurrency(), 1u);
+        for (std::size_t const coroutinesCount : { 1'000, 100'000, 1'000'000 })
+        {
+            std::string const suffix = "." + std::to_string(coroutinesCount);
+            _RunResume<PriorityQueueScheduler<int, tDecrement>>("scheduler.resume.heap" + suffix, coroutinesCount, 1);
+            _RunResume<PriorityQueueScheduler<int, tDecrement, std::ranges::less, BucketJobQueue>>(
+                "scheduler.resume.bucket" + suffix, coroutinesCount, 1);
+            _RunResume<ConcurrentPriorityQueueScheduler<int, tDecrement>>(
+                "scheduler.resume.concurrent" + suffix, coroutinesCount, workersCount, workersCount);
+            _RunDeadlineResume(coroutinesCount);
+        }
+    }
+} /// end namespace Darkness::Benchmark
@@ -0,0 +1,122 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    SpinlockBenchmark.cpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Contention benchmarks of locks.
+
+#include "Benchmark.hpp"
+
+#include <Darkness/Concurrency/Spinlock.hpp>
+#include <Darkness/Concurrency/TicketLock.hpp>
+#include <Darkness/Concurrency/McsLock.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace Darkness::Benchmark {
+    namespace {
+        /// @short The previous Spinlock realization, is kept as the reference point.
+        class TasSpinlock final
+        {
+        public:
+            void lock() noexcept
+            {
+                while (m_Flag.test_and_set(std::memory_order_acquire))
+                {
+                }
+            }
+
+            void unlock() noexcept
+            {
+                m_Flag.clear(std::memory_order_release);
+            }
+
+        private:
+            std::atomic_flag m_Flag;
+        };
+
+        constexpr std::size_t const _OperationsPerRun = 2'000'000;
+
+        template<typename LockT>
+        void _RunContention(std::string const& name, std::size_t threadsCount)
+        {
+            LockT lock;
+            std::uint64_t counter = 0;
+            std::size_t const operationsPerThread = _OperationsPerRun / threadsCount;
+
+            auto const elapsed = RunOnThreads(threadsCount, [&](std::size_t) {
+                for (std::size_t i = 0; i < operationsPerThread; ++i)
+                {
+                    std::lock_guard<LockT> const guard(lock);
+                    ++counter;
+                }
+            });
+
+            if (counter != operationsPerThread * threadsCount)
+            {
+                std::fprintf(stderr, "%s: bad counter %llu\n", name.c_str(), static_cast<unsigned long long>(counter));
+            }
+
+            Report(name, threadsCount, operationsPerThread * threadsCount, elapsed);
+        }
+
+        constexpr std::size_t const _Handoffs = 20'000;
+
+        /// @short Two threads pass the turn to each other through the lock, so each acquisition after a handoff
+        ///        takes the lock which was just released by the other thread.
+        template<typename LockT>
+        void _RunHandoff(std::string const& name)
+        {
+            LockT lock;
+            std::size_t turn = 0;
+            std::size_t handoffs = 0;
+
+            auto const elapsed = RunOnThreads(2, [&](std::size_t index) {
+                while (true)
+                {
+                    {
+                        std::lock_guard<LockT> const guard(lock);
+                        if (handoffs >= _Handoffs)
+                        {
+                            return;
+                        }
+
+                        if (turn == index)
+                        {
+                            turn = 1 - index;
+                            ++handoffs;
+                            continue;
+                        }
+                    }
+
+                    /// @short Not our turn: let the other thread run, otherwise on an oversubscribed machine
+                    ///        the waiting thread burns its whole time slice.
+                    std::this_thread::yield();
+                }
+            });
+
+            Report(name, 2, _Handoffs, elapsed);
+        }
+    } /// end unnamed namespace
+
+    void RunSpinlockBenchmarks()
+    {
+        for (std::size_t const threadsCount : { 2, 8, 32 })
+        {
+            _RunContention<TasSpinlock>("lock.contention.tas_spinlock", threadsCount);
+            _RunContention<Concurrency::Spinlock>("lock.contention.spinlock", threadsCount);
+            _RunContention<Concurrency::TicketLock>("lock.contention.ticket_lock", threadsCount);
+            _RunContention<Concurrency::McsLock>("lock.contention.mcs_lock", threadsCount);
+            _RunContention<std::mutex>("lock.contention.std_mutex", threadsCount);
+        }
+
+        _RunHandoff<Concurrency::Spinlock>("lock.handoff.spinlock");
+        _RunHandoff<Concurrency::TicketLock>("lock.handoff.ticket_lock");
+        _RunHandoff<Concurrency::McsLock>("lock.handoff.mcs_lock");
+        _RunHandoff<std::mutex>("lock.handoff.std_mutex");
+    }
+} /// end namespace Darkness::Benchmark
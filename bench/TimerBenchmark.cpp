@@ -0,0 +1,67 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    TimerBenchmark.cpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Firing jitter benchmarks of AsyncTimer.
+
+#include "Benchmark.hpp"
+
+#include <Darkness/Concurrency/AsyncTimer.hpp>
+#include <Darkness/Concurrency/Event.hpp>
+#include <Darkness/Concurrency/TimerService.hpp>
+
+#include <cmath>
+#include <optional>
+
+namespace Darkness::Benchmark {
+    namespace {
+        constexpr std::chrono::milliseconds const _Period { 1 };
+        constexpr std::size_t const _Ticks = 300;
+
+        /// @short The jitter of a tick is the deviation of the interval from the previous tick from the period.
+        void _RunJitter(std::string const& name, Concurrency::AsyncTimerOptions options)
+        {
+            std::vector<double> samples;
+            samples.reserve(_Ticks);
+            std::optional<tClock::time_point> previous;
+            Concurrency::tAtomicEvent finished;
+
+            options.mode = Concurrency::eTimerMode::FixedRate;
+            Concurrency::AsyncTimer timer(_Period, [&] {
+                auto const now = tClock::now();
+                if (previous && samples.size() < _Ticks)
+                {
+                    double const interval = std::chrono::duration<double, std::nano>(now - *previous).count();
+                    samples.push_back(std::abs(interval - std::chrono::duration<double, std::nano>(_Period).count()));
+                    if (samples.size() == _Ticks)
+                    {
+                        finished.Set();
+                    }
+                }
+
+                previous = now;
+            }, "Darkness.Benchmark.Timer", {}, std::move(options));
+
+            timer.Start();
+            (void) finished.Wait();
+
+            ReportPercentiles(name, 1, samples);
+        }
+    } /// end unnamed namespace
+
+    void RunTimerBenchmarks()
+    {
+        _RunJitter("timer.jitter.dedicated", {});
+
+        Concurrency::AsyncTimerOptions spinning;
+        spinning.spinWindow = std::chrono::microseconds(100);
+        _RunJitter("timer.jitter.dedicated.spin_100us", std::move(spinning));
+
+        Concurrency::AsyncTimerOptions shared;
+        shared.timerService = Concurrency::TimerService::Instance();
+        _RunJitter("timer.jitter.service", std::move(shared));
+    }
+} /// end namespace Darkness::Benchmark
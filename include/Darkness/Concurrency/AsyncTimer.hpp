@@ -10,12 +10,53 @@
 #pragma once
 
 #include <Darkness/Concurrency/Types.hpp>
+#include <Darkness/Concurrency/TimerService.hpp>
 
 #include <chrono>
+#include <cstdint>
 #include <string>
 #include <memory>
 
 namespace Darkness::Concurrency {
+    /// @brief The options of an AsyncTimer object.
+    struct AsyncTimerOptions final
+    {
+        /// @brief The shared service which executes the timer. If empty, the timer owns a dedicated thread.
+        ///        @short Use TimerService::Instance() to run many timers on one thread. The timer keeps ticking
+        ///               after an exception of its task, the exception is passed to the exception handler.
+        tTimerServicePtr timerService {};
+
+        /// @brief The queue for execution of the task when the timer is executed by the service.
+        ///        If empty, the task is executed on the service thread and should be short.
+        tQueueWeakPtr dispatchQueue {};
+
+        /// @brief Fixed delay (the delay is counted from the end of the previous tick) or fixed rate (the ticks are
+        ///        aligned to absolute steady_clock deadlines).
+        eTimerMode mode { eTimerMode::FixedDelay };
+
+        /// @brief What to do with the missed ticks in the fixed-rate mode.
+        eMissedTickPolicy missedTickPolicy { eMissedTickPolicy::Skip };
+
+        /// @brief High-resolution mode. The timer thread sleeps until spinWindow before the deadline and then spins
+        ///        until the exact deadline. Zero disables spinning.
+        ///        @short Is applied only to a timer with a dedicated thread. The spinning burns a CPU core for up to
+        ///               spinWindow per tick, so it should be a bit longer than the typical oversleep of the OS.
+        std::chrono::nanoseconds spinWindow { 0 };
+
+        /// @brief The attributes of the dedicated timer thread. Are not applied to the timer service thread.
+        ThreadAttributes threadAttributes {};
+    };
+
+    /// @brief Observed lateness of the ticks, the difference between the actual start of a tick and its deadline.
+    struct TimerLatenessStatistics final
+    {
+        std::uint64_t count = 0;
+        std::chrono::nanoseconds min { 0 };
+        std::chrono::nanoseconds max { 0 };
+        std::chrono::nanoseconds mean { 0 };
+        std::chrono::nanoseconds last { 0 };
+    };
+
     class AsyncTimer final
     {
         class _Impl;
@@ -33,11 +74,13 @@ namespace Darkness::Concurrency {
         ///        @short If an exception will be occurred then a timer object will store result of call
         ///               std::current_exception(), after that it will be stopped and stored exception will
         ///               passed to an exceptionHandler.
+        /// @param options The options of the timer.
         template<typename Representation, typename Period>
         explicit AsyncTimer(std::chrono::duration<Representation, Period> const& durationDelay, tTask task
-                            , std::string name = "", tExceptionHandler exceptionHandler = {}) noexcept(false)
+                            , std::string name = "", tExceptionHandler exceptionHandler = {}
+                            , AsyncTimerOptions options = {}) noexcept(false)
             : AsyncTimer(std::chrono::duration_cast<tDurationDelay>(durationDelay)
-                         , std::move(task), std::move(name), std::move(exceptionHandler))
+                         , std::move(task), std::move(name), std::move(exceptionHandler), std::move(options))
         {
         }
 
@@ -50,8 +93,10 @@ namespace Darkness::Concurrency {
         ///        @short If an exception will be occurred then a timer object will store result of call
         ///               std::current_exception(), after that it will be stopped and stored exception will
         ///               passed to an exceptionHandler.
+        /// @param options The options of the timer.
         explicit AsyncTimer(tDurationDelayRuntimeProvider const& durationDelayRuntimeProvider, tTask task
-                            , std::string name = "", tExceptionHandler exceptionHandler = {}) noexcept(false);
+                            , std::string name = "", tExceptionHandler exceptionHandler = {}
+                            , AsyncTimerOptions options = {}) noexcept(false);
 
         AsyncTimer() noexcept;
 
@@ -76,9 +121,16 @@ namespace Darkness::Concurrency {
         /// @warning Should not be called from the timer task.
         void Stop() noexcept;
 
+        /// @brief Returns the lateness statistics of the ticks. Is collected only by a timer with a dedicated thread.
+        [[nodiscard]] TimerLatenessStatistics GetLatenessStatistics() const noexcept;
+
+        /// @brief Resets the lateness statistics.
+        void ResetLatenessStatistics() noexcept;
+
     private:
         explicit AsyncTimer(tDurationDelay const& durationDelay, tTask task
-                            , std::string name = "", tExceptionHandler exceptionHandler = {}) noexcept(false);
+                            , std::string name = "", tExceptionHandler exceptionHandler = {}
+                            , AsyncTimerOptions options = {}) noexcept(false);
 
     private:
         std::unique_ptr<_Impl> m_Impl;
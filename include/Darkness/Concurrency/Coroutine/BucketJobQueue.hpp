@@ -0,0 +1,192 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    BucketJobQueue.hpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Implementation of @class BucketJobQueue. Job queue of PriorityQueueScheduler for small integral
+///          priorities.
+///          @short Each of 256 priority levels is a FIFO ring of coroutine handles. A two-level bitmap of non-empty
+///                 levels gives the next level by one bit scan, so push and pop cost O(1) regardless of the number
+///                 of jobs. Priorities outside [0, 255] are clamped. Jobs of one level are resumed in FIFO order.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Darkness::Concurrency::Coroutine {
+    /// @param ComparatorT std::ranges::less resumes the highest priority first (as std::priority_queue does),
+    ///        std::ranges::greater resumes the lowest priority first.
+    template<typename PriorityT, typename ComparatorT>
+        requires std::integral<PriorityT>
+    class BucketJobQueue final
+    {
+        static_assert(std::is_same_v<ComparatorT, std::ranges::less>
+                      || std::is_same_v<ComparatorT, std::ranges::greater>
+                      , "BucketJobQueue supports only std::ranges::less and std::ranges::greater!");
+
+        using tWord = std::uint64_t;
+
+        /// @brief Ring of handles which grows by doubling.
+        class _Bucket final
+        {
+        public:
+            [[nodiscard]] bool IsEmpty() const noexcept
+            {
+                return m_Count == 0;
+            }
+
+            void Push(std::coroutine_handle<> task)
+            {
+                if (m_Count == m_Items.size())
+                {
+                    _Grow();
+                }
+
+                m_Items[(m_Head + m_Count) & (m_Items.size() - 1)] = task;
+                ++m_Count;
+            }
+
+            [[nodiscard]] std::coroutine_handle<> Front() const noexcept
+            {
+                return m_Items[m_Head];
+            }
+
+            void Pop() noexcept
+            {
+                m_Head = (m_Head + 1) & (m_Items.size() - 1);
+                --m_Count;
+            }
+
+        private:
+            void _Grow()
+            {
+                std::vector<std::coroutine_handle<>> items(std::max<std::size_t>(m_Items.size() * 2, _InitialCapacity));
+                for (std::size_t index = 0; index < m_Count; ++index)
+                {
+                    items[index] = m_Items[(m_Head + index) & (m_Items.size() - 1)];
+                }
+
+                m_Items.swap(items);
+                m_Head = 0;
+            }
+
+        private:
+            static constexpr std::size_t const _InitialCapacity = 8;
+
+            std::vector<std::coroutine_handle<>> m_Items;
+            std::size_t m_Head { 0 };
+            std::size_t m_Count { 0 };
+        };
+
+    public:
+        using value_type = std::pair<PriorityT, std::coroutine_handle<>>;
+        using size_type = std::size_t;
+
+    public:
+        void emplace(PriorityT priority, std::coroutine_handle<> task)
+        {
+            std::size_t const level = Clamp(priority);
+            m_Buckets[level].Push(task);
+            m_Levels[level / _WordBits] |= tWord(1) << (level % _WordBits);
+            m_Words |= tWord(1) << (level / _WordBits);
+            ++m_Size;
+        }
+
+        void push(value_type const& job)
+        {
+            emplace(job.first, job.second);
+        }
+
+        [[nodiscard]] value_type top() const noexcept
+        {
+            assert(!empty() && "Bad logic! The queue is empty!");
+
+            std::size_t const level = _NextLevel();
+            return { static_cast<PriorityT>(level), m_Buckets[level].Front() };
+        }
+
+        void pop() noexcept
+        {
+            assert(!empty() && "Bad logic! The queue is empty!");
+
+            std::size_t const level = _NextLevel();
+            _Bucket& bucket = m_Buckets[level];
+            bucket.Pop();
+            if (bucket.IsEmpty())
+            {
+                tWord& word = m_Levels[level / _WordBits];
+                word &= ~(tWord(1) << (level % _WordBits));
+                if (word == 0)
+                {
+                    m_Words &= ~(tWord(1) << (level / _WordBits));
+                }
+            }
+
+            --m_Size;
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return m_Size == 0;
+        }
+
+        [[nodiscard]] size_type size() const noexcept
+        {
+            return m_Size;
+        }
+
+        /// @brief Returns the level of the priority.
+        [[nodiscard]] static constexpr std::size_t Clamp(PriorityT priority) noexcept
+        {
+            if constexpr (std::is_signed_v<PriorityT>)
+            {
+                if (priority < 0)
+                {
+                    return 0;
+                }
+            }
+
+            return static_cast<std::size_t>(std::min<std::make_unsigned_t<PriorityT>>(
+                static_cast<std::make_unsigned_t<PriorityT>>(priority), LevelsCount - 1));
+        }
+
+    private:
+        [[nodiscard]] std::size_t _NextLevel() const noexcept
+        {
+            if constexpr (std::is_same_v<ComparatorT, std::ranges::less>)
+            {
+                std::size_t const word = _WordBits - 1 - std::countl_zero(m_Words);
+                return word * _WordBits + (_WordBits - 1 - std::countl_zero(m_Levels[word]));
+            }
+            else
+            {
+                std::size_t const word = std::countr_zero(m_Words);
+                return word * _WordBits + std::countr_zero(m_Levels[word]);
+            }
+        }
+
+    public:
+        static constexpr std::size_t const LevelsCount = 256;
+
+    private:
+        static constexpr std::size_t const _WordBits = 64;
+
+        std::array<_Bucket, LevelsCount> m_Buckets;
+        std::array<tWord, LevelsCount / _WordBits> m_Levels {};
+        tWord m_Words { 0 };
+        std::size_t m_Size { 0 };
+    };
+} /// end namespace Darkness::Concurrency::Coroutine
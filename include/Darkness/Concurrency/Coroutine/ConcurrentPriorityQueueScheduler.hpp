@@ -0,0 +1,343 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    ConcurrentPriorityQueueScheduler.hpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Implementation of @class ConcurrentPriorityQueueScheduler. PriorityQueueScheduler which resumes
+///          coroutines on many threads.
+///          @short The jobs are kept in a relaxed MultiQueue: several heaps, each under its own spinlock.
+///                 A job is pushed into a random heap, a worker pops from the better of two random heaps.
+///                 The order is therefore approximate: a job may be resumed before a job of a slightly
+///                 higher priority. Tasks can be added from any thread while the scheduling is in progress.
+
+#pragma once
+
+#include <Darkness/Concurrency/Coroutine/PriorityQueueScheduler.hpp>
+#include <Darkness/Concurrency/Spinlock.hpp>
+#include <Darkness/Concurrency/Tracer.hpp>
+#include <Darkness/Concurrency/Types.hpp>
+#include <Darkness/Concurrency/Utilities.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <coroutine>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Darkness::Concurrency::Coroutine {
+    template<
+        typename PriorityT = int
+        , typename UpdaterT = std::identity
+        , typename ComparatorT = std::ranges::less>
+    requires
+    std::invocable<decltype(UpdaterT()), PriorityT>
+    && std::predicate<decltype(ComparatorT()), Job<PriorityT>, Job<PriorityT>>
+    class ConcurrentPriorityQueueScheduler final
+    {
+    public:
+        using tPriority = PriorityT;
+
+    private:
+        using tJob = Job<tPriority>;
+        using tJobQueueContainer = std::vector<tJob>;
+        using tLock = std::lock_guard<Spinlock> const;
+
+        struct alignas(CacheLineSize) _Heap final
+        {
+            Spinlock access;
+            tJobQueueContainer jobs;
+            /// @short Copies of the heap state for choosing a heap without the lock.
+            std::atomic<std::size_t> size { 0 };
+            std::atomic<tPriority> top {};
+        };
+
+        using tHeaps = std::unique_ptr<_Heap[]>;
+
+    public:
+        /// @param workersCount The number of threads which resume coroutines, including the thread of Schedule.
+        explicit ConcurrentPriorityQueueScheduler(std::size_t workersCount = std::thread::hardware_concurrency())
+            : m_WorkersCount(std::max<std::size_t>(workersCount, 1))
+              , m_HeapsCount(std::max<std::size_t>(m_WorkersCount * _HeapsPerWorker, 2))
+              , m_Heaps(std::make_unique<_Heap[]>(m_HeapsCount))
+        {
+        }
+
+        /// @short Coroutines which were not scheduled are destroyed.
+        ~ConcurrentPriorityQueueScheduler()
+        {
+            for (std::size_t index = 0; index < m_HeapsCount; ++index)
+            {
+                for (auto& [priority, task] : m_Heaps[index].jobs)
+                {
+                    task.destroy();
+                }
+            }
+        }
+
+        ConcurrentPriorityQueueScheduler(ConcurrentPriorityQueueScheduler const&) = delete;
+
+        ConcurrentPriorityQueueScheduler(ConcurrentPriorityQueueScheduler&&) = delete;
+
+        ConcurrentPriorityQueueScheduler& operator=(ConcurrentPriorityQueueScheduler const&) = delete;
+
+        ConcurrentPriorityQueueScheduler& operator=(ConcurrentPriorityQueueScheduler&&) = delete;
+
+        /// @brief Adds the coroutine. Can be called from any thread, including the resumed coroutines.
+        /// @param task The scheduler takes the ownership and destroys the coroutine when it is done.
+        void AddTask(tPriority priority, std::coroutine_handle<> task)
+        {
+            m_Pending.fetch_add(1, std::memory_order_relaxed);
+            _Push({ priority, task });
+        }
+
+        /// @brief Resumes the coroutines on workersCount threads till all of them are done.
+        /// @short Each resumed coroutine which is not done is returned with the updated priority.
+        ///        The coroutines should only suspend by awaiters which do not resume them elsewhere,
+        ///        like std::suspend_always. Should not be called while another Schedule is in progress.
+        void Schedule()
+        {
+            std::vector<std::jthread> workers;
+            workers.reserve(m_WorkersCount - 1);
+            for (std::size_t index = 1; index < m_WorkersCount; ++index)
+            {
+                workers.emplace_back([this] { _Work(); });
+            }
+
+            _Work();
+        }
+
+        /// @brief Returns the number of added coroutines which are not done yet.
+        [[nodiscard]] std::size_t GetPendingCount() const noexcept
+        {
+            return m_Pending.load(std::memory_order_acquire);
+        }
+
+    private:
+        void _Work()
+        {
+            UpdaterT updater = {};
+#if defined(Darkness_Concurrency_TRACE)
+            static Tracer::tNameId const traceNameId = Tracer::Instance().Intern("ConcurrentPriorityQueueScheduler");
+#endif /// Darkness_Concurrency_TRACE
+            tJob job;
+            while (true)
+            {
+                if (!_TryPop(job))
+                {
+                    if (m_Pending.load(std::memory_order_acquire) == 0)
+                    {
+                        return;
+                    }
+
+                    _Idle();
+                    continue;
+                }
+
+                auto [priority, task] = job;
+                {
+#if defined(Darkness_Concurrency_TRACE)
+                    TraceScope const traceScope(traceNameId, eTraceCategory::Scheduler);
+#endif /// Darkness_Concurrency_TRACE
+                    task.resume();
+                }
+
+                if (task.done())
+                {
+                    task.destroy();
+                    if (m_Pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    {
+                        m_Epoch.fetch_add(1, std::memory_order_seq_cst);
+                        m_Epoch.notify_all();
+                    }
+                }
+                else
+                {
+                    _Push({ updater(priority), task });
+                }
+            }
+        }
+
+        void _Push(tJob job)
+        {
+            ComparatorT comparator = {};
+            _Heap& heap = m_Heaps[_Random() % m_HeapsCount];
+            {
+                tLock lock(heap.access);
+                heap.jobs.push_back(job);
+                std::push_heap(heap.jobs.begin(), heap.jobs.end(), comparator);
+                heap.top.store(heap.jobs.front().first, std::memory_order_relaxed);
+                heap.size.store(heap.jobs.size(), std::memory_order_seq_cst);
+            }
+
+            if (m_Sleepers.load(std::memory_order_seq_cst) != 0)
+            {
+                m_Epoch.fetch_add(1, std::memory_order_seq_cst);
+                m_Epoch.notify_one();
+            }
+        }
+
+        [[nodiscard]] bool _TryPop(tJob& job)
+        {
+            for (std::size_t attempt = 0; attempt < m_HeapsCount; ++attempt)
+            {
+                _Heap* const heap = _Better(m_Heaps[_Random() % m_HeapsCount], m_Heaps[_Random() % m_HeapsCount]);
+                if (heap && heap->access.try_lock())
+                {
+                    bool const isPopped = _PopLocked(*heap, job);
+                    heap->access.unlock();
+                    if (isPopped)
+                    {
+                        return true;
+                    }
+                }
+            }
+
+            /// @short The random probes failed, so the heaps are swept to not leave a job unnoticed.
+            std::size_t const start = _Random();
+            for (std::size_t index = 0; index < m_HeapsCount; ++index)
+            {
+                _Heap& heap = m_Heaps[(start + index) % m_HeapsCount];
+                if (heap.size.load(std::memory_order_acquire) != 0)
+                {
+                    tLock lock(heap.access);
+                    if (_PopLocked(heap, job))
+                    {
+                        return true;
+                    }
+                }
+            }
+
+            return false;
+        }
+
+        [[nodiscard]] static bool _PopLocked(_Heap& heap, tJob& job)
+        {
+            if (heap.jobs.empty())
+            {
+                return false;
+            }
+
+            ComparatorT comparator = {};
+            std::pop_heap(heap.jobs.begin(), heap.jobs.end(), comparator);
+            job = heap.jobs.back();
+            heap.jobs.pop_back();
+            if (!heap.jobs.empty())
+            {
+                heap.top.store(heap.jobs.front().first, std::memory_order_relaxed);
+            }
+
+            heap.size.store(heap.jobs.size(), std::memory_order_release);
+            return true;
+        }
+
+        /// @brief Chooses the heap with the higher top priority by the cached state.
+        [[nodiscard]] static _Heap* _Better(_Heap& first, _Heap& second) noexcept
+        {
+            bool const isFirstEmpty = first.size.load(std::memory_order_acquire) == 0;
+            bool const isSecondEmpty = second.size.load(std::memory_order_acquire) == 0;
+            if (isFirstEmpty || isSecondEmpty)
+            {
+                return isFirstEmpty ? (isSecondEmpty ? nullptr : &second) : &first;
+            }
+
+            ComparatorT comparator = {};
+            tJob const firstTop { first.top.load(std::memory_order_relaxed), {} };
+            tJob const secondTop { second.top.load(std::memory_order_relaxed), {} };
+            return comparator(firstTop, secondTop) ? &second : &first;
+        }
+
+        /// @short Spins for a while, then sleeps till a job is pushed or all coroutines are done.
+        void _Idle()
+        {
+            for (std::size_t round = 0; round < _SpinRounds; ++round)
+            {
+                if (_HasJobs() || m_Pending.load(std::memory_order_acquire) == 0)
+                {
+                    return;
+                }
+
+                CpuRelax();
+            }
+
+            std::uint32_t const epoch = m_Epoch.load(std::memory_order_seq_cst);
+            m_Sleepers.fetch_add(1, std::memory_order_seq_cst);
+            if (!_HasJobs() && m_Pending.load(std::memory_order_seq_cst) != 0)
+            {
+                m_Epoch.wait(epoch, std::memory_order_seq_cst);
+            }
+
+            m_Sleepers.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] bool _HasJobs() const noexcept
+        {
+            for (std::size_t index = 0; index < m_HeapsCount; ++index)
+            {
+                if (m_Heaps[index].size.load(std::memory_order_seq_cst) != 0)
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /// @brief Thread-local xorshift generator for choosing heaps.
+        [[nodiscard]] static std::size_t _Random() noexcept
+        {
+            static std::atomic<std::uint32_t> seeds { 0x9E3779B9u };
+            thread_local std::uint32_t state = seeds.fetch_add(0x9E3779B9u, std::memory_order_relaxed) | 1u;
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+
+    private:
+        static constexpr std::size_t const _HeapsPerWorker = 4;
+        static constexpr std::size_t const _SpinRounds = 64;
+
+        std::size_t const m_WorkersCount;
+        std::size_t const m_HeapsCount;
+        tHeaps const m_Heaps;
+        alignas(CacheLineSize) std::atomic<std::size_t> m_Pending { 0 };
+        alignas(CacheLineSize) std::atomic<std::uint32_t> m_Epoch { 0 };
+        std::atomic<std::size_t> m_Sleepers { 0 };
+    };
+} /// end namespace Darkness::Concurrency::Coroutine
+
+/**
+ * @code
+    Task<> createTask(std::atomic<int>& steps)
+    {
+        for (size_t i = 0; i < 3; ++i)
+        {
+            steps.fetch_add(1);
+
+            co_await std::suspend_always();
+        }
+    }
+
+    void CoroutineConcurrentPriorityQueueScheduler()
+    {
+        std::atomic<int> steps = 0;
+
+        ConcurrentPriorityQueueScheduler<int, decltype([](int a) { return a - 1; })> scheduler(4);
+
+        for (int priority = 0; priority < 1000; ++priority)
+        {
+            scheduler.AddTask(priority, createTask(steps).release());
+        }
+
+        scheduler.Schedule();
+
+        std::cout << steps << std::endl;
+    }
+*/
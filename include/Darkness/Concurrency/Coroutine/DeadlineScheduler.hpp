@@ -0,0 +1,245 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    DeadlineScheduler.hpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Implementation of @class DeadlineScheduler. Earliest-deadline-first scheduler of coroutines.
+///          @short Each job has a steady_clock deadline, the job with the earliest one is resumed first. A deadline
+///                 is updated lazily: a new heap entry is pushed and the old one becomes stale by its version and
+///                 is skipped when it reaches the top. A job which is resumed after its deadline is reported as
+///                 missed once per deadline.
+
+#pragma once
+
+#include <Darkness/Concurrency/Coroutine/Task.hpp>
+#include <Darkness/Concurrency/Tracer.hpp>
+
+#include <chrono>
+#include <concepts>
+#include <coroutine>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Darkness::Concurrency::Coroutine {
+    /// @param UpdaterT Gives the next deadline of a job which is suspended but not done.
+    template<typename UpdaterT = std::identity>
+        requires std::regular_invocable<UpdaterT, std::chrono::steady_clock::time_point>
+    class DeadlineScheduler final
+    {
+    public:
+        using tClock = std::chrono::steady_clock;
+        using tTimePoint = tClock::time_point;
+        using tJobId = std::uint64_t;
+        using tMissHandler = std::function<void(tJobId id, tTimePoint deadline, tTimePoint now)>;
+
+    private:
+        struct _Record final
+        {
+            std::coroutine_handle<> task;
+            tTimePoint deadline;
+            std::uint64_t version;
+            bool isMissReported;
+        };
+
+        struct _Entry final
+        {
+            tTimePoint deadline;
+            std::uint64_t version;
+            tJobId id;
+        };
+
+        /// @short The earliest deadline is on the top, equal deadlines are taken in order of pushing.
+        struct _EntryComparator final
+        {
+            [[nodiscard]] bool operator()(_Entry const& first, _Entry const& second) const noexcept
+            {
+                return first.deadline != second.deadline ? first.deadline > second.deadline
+                                                         : first.version > second.version;
+            }
+        };
+
+        using tRecords = std::unordered_map<tJobId, _Record>;
+        using tEntries = std::priority_queue<_Entry, std::vector<_Entry>, _EntryComparator>;
+
+    public:
+        explicit DeadlineScheduler(tMissHandler missHandler = {})
+            : m_MissHandler(std::move(missHandler))
+        {
+        }
+
+        /// @short Coroutines which were not scheduled are destroyed.
+        ~DeadlineScheduler()
+        {
+            for (auto& [id, record] : m_Records)
+            {
+                record.task.destroy();
+            }
+        }
+
+        DeadlineScheduler(DeadlineScheduler const&) = delete;
+
+        DeadlineScheduler(DeadlineScheduler&&) = delete;
+
+        DeadlineScheduler& operator=(DeadlineScheduler const&) = delete;
+
+        DeadlineScheduler& operator=(DeadlineScheduler&&) = delete;
+
+        /// @param task The scheduler takes the ownership and destroys the coroutine when it is done.
+        /// @return The id of the job for UpdateDeadline.
+        tJobId AddTask(tTimePoint deadline, std::coroutine_handle<> task)
+        {
+            tJobId const id = ++m_LastJobId;
+            std::uint64_t const version = ++m_LastVersion;
+            m_Records.emplace(id, _Record { task, deadline, version, false });
+            m_Entries.push({ deadline, version, id });
+            return id;
+        }
+
+        template<typename Representation, typename Period>
+        tJobId AddTask(std::chrono::duration<Representation, Period> const& budget, std::coroutine_handle<> task)
+        {
+            return AddTask(tClock::now() + std::chrono::duration_cast<tClock::duration>(budget), task);
+        }
+
+        /// @brief Changes the deadline of the job in O(log n). Can be called from the resumed coroutines.
+        /// @return false if the job is done or the id is wrong.
+        bool UpdateDeadline(tJobId id, tTimePoint deadline)
+        {
+            auto const found = m_Records.find(id);
+            if (found == m_Records.end())
+            {
+                return false;
+            }
+
+            _Repush(id, found->second, deadline);
+            return true;
+        }
+
+        /// @brief Resumes the coroutines in order of their deadlines till all of them are done.
+        void Schedule()
+        {
+            UpdaterT updater = {};
+#if defined(Darkness_Concurrency_TRACE)
+            static Tracer::tNameId const traceNameId = Tracer::Instance().Intern("DeadlineScheduler");
+#endif /// Darkness_Concurrency_TRACE
+            while (!m_Entries.empty())
+            {
+                _Entry const entry = m_Entries.top();
+                m_Entries.pop();
+
+                auto const found = m_Records.find(entry.id);
+                if (found == m_Records.end() || found->second.version != entry.version)
+                {
+                    continue;
+                }
+
+                _Record& record = found->second;
+                if (!record.isMissReported)
+                {
+                    tTimePoint const now = tClock::now();
+                    if (now > record.deadline)
+                    {
+                        record.isMissReported = true;
+                        ++m_MissedCount;
+                        if (m_MissHandler)
+                        {
+                            m_MissHandler(entry.id, record.deadline, now);
+                        }
+                    }
+                }
+
+                std::coroutine_handle<> const task = record.task;
+                {
+#if defined(Darkness_Concurrency_TRACE)
+                    TraceScope const traceScope(traceNameId, eTraceCategory::Scheduler);
+#endif /// Darkness_Concurrency_TRACE
+                    task.resume();
+                }
+
+                /// @short The coroutine may add jobs, so the record is looked up again.
+                auto const resumed = m_Records.find(entry.id);
+                if (task.done())
+                {
+                    task.destroy();
+                    m_Records.erase(resumed);
+                }
+                else
+                {
+                    _Repush(entry.id, resumed->second, updater(resumed->second.deadline));
+                }
+            }
+        }
+
+        /// @brief Returns the number of deadlines which were missed.
+        [[nodiscard]] std::uint64_t GetMissedCount() const noexcept
+        {
+            return m_MissedCount;
+        }
+
+        /// @brief Returns the number of jobs which are not done yet.
+        [[nodiscard]] std::size_t GetTasksCount() const noexcept
+        {
+            return m_Records.size();
+        }
+
+    private:
+        void _Repush(tJobId id, _Record& record, tTimePoint deadline)
+        {
+            if (deadline != record.deadline)
+            {
+                record.deadline = deadline;
+                record.isMissReported = false;
+            }
+
+            record.version = ++m_LastVersion;
+            m_Entries.push({ deadline, record.version, id });
+        }
+
+    private:
+        tRecords m_Records;
+        tEntries m_Entries;
+        tMissHandler m_MissHandler;
+        tJobId m_LastJobId { 0 };
+        std::uint64_t m_LastVersion { 0 };
+        std::uint64_t m_MissedCount { 0 };
+    };
+} /// end namespace Darkness::Concurrency::Coroutine
+
+/**
+ * @code
+    Task<> createTask(std::string name, std::chrono::milliseconds work)
+    {
+        std::cout << name << " start\n";
+
+        co_await std::suspend_always();
+
+        std::this_thread::sleep_for(work);
+
+        std::cout << name << " finish\n";
+    }
+
+    void CoroutineDeadlineScheduler()
+    {
+        using namespace std::chrono_literals;
+
+        DeadlineScheduler<> scheduler([](auto id, auto deadline, auto now) {
+            std::cout << "job " << id << " is late by " << (now - deadline) / 1us << " us\n";
+        });
+
+        scheduler.AddTask(30ms, createTask("Relaxed", 5ms).release());
+        auto const urgent = scheduler.AddTask(10ms, createTask("Urgent", 5ms).release());
+        scheduler.AddTask(20ms, createTask("Normal", 30ms).release());
+
+        scheduler.UpdateDeadline(urgent, std::chrono::steady_clock::now() + 1ms);
+
+        scheduler.Schedule();
+
+        std::cout << scheduler.GetMissedCount() << " deadlines are missed" << std::endl;
+    }
+*/
@@ -0,0 +1,148 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    FramePool.hpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Declaration of @class FramePool and @class PooledFrameAllocation. Allocation of coroutine frames.
+///          @short FramePool keeps freed frames in thread-local size-class free lists. Surplus frames are moved in
+///                 batches to a shared depot, so frames which are freed on another thread are recycled too.
+///                 PooledFrameAllocation is a base of promise types which allocates their frames from the pool or,
+///                 if the coroutine is called with std::allocator_arg and an allocator, from that allocator.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace Darkness::Concurrency::Coroutine {
+    class FramePool final
+    {
+    public:
+        FramePool() = delete;
+
+        /// @brief Allocates a block of at least size bytes aligned as std::max_align_t.
+        /// @short Blocks larger than MaxPooledSize are allocated by the global operator new.
+        [[nodiscard]] static void* Allocate(std::size_t size);
+
+        /// @param size The same size which was passed into Allocate.
+        static void Deallocate(void* block, std::size_t size) noexcept;
+
+    public:
+        static constexpr std::size_t const Granularity = 64;
+        static constexpr std::size_t const MaxPooledSize = 2048;
+    };
+
+    class PooledFrameAllocation
+    {
+        using tDeallocate = void (*)(void* frame, std::size_t size) noexcept;
+
+        struct alignas(std::max_align_t) _Block final
+        {
+            std::byte bytes[alignof(std::max_align_t)];
+        };
+
+    public:
+        static void* operator new(std::size_t size)
+        {
+            void* const frame = FramePool::Allocate(_TrailerOffset(size) + sizeof(tDeallocate));
+            ::new (_Trailer(frame, size)) tDeallocate(nullptr);
+            return frame;
+        }
+
+        /// @brief Is selected when the coroutine is called as f(std::allocator_arg, allocator, args...).
+        /// @short The allocator is copied behind the frame to deallocate the frame by it.
+        ///        std::pmr::polymorphic_allocator allows to allocate frames from an arena.
+        template<typename AllocatorT, typename... ArgsT>
+        static void* operator new(std::size_t size, std::allocator_arg_t, AllocatorT const& allocator
+                                  , ArgsT const&...)
+        {
+            return _AllocateWith(size, allocator);
+        }
+
+        /// @brief The same for member coroutines, the first argument is the object.
+        template<typename ObjectT, typename AllocatorT, typename... ArgsT>
+        static void* operator new(std::size_t size, ObjectT const&, std::allocator_arg_t
+                                  , AllocatorT const& allocator, ArgsT const&...)
+        {
+            return _AllocateWith(size, allocator);
+        }
+
+        static void operator delete(void* frame, std::size_t size) noexcept
+        {
+            if (tDeallocate const deallocate = *_Trailer(frame, size))
+            {
+                deallocate(frame, size);
+            }
+            else
+            {
+                FramePool::Deallocate(frame, _TrailerOffset(size) + sizeof(tDeallocate));
+            }
+        }
+
+    private:
+        template<typename AllocatorT>
+        using tBlockAllocator = typename std::allocator_traits<AllocatorT>::template rebind_alloc<_Block>;
+
+        static constexpr std::size_t _AlignUp(std::size_t size, std::size_t alignment) noexcept
+        {
+            return (size + alignment - 1) & ~(alignment - 1);
+        }
+
+        static constexpr std::size_t _TrailerOffset(std::size_t size) noexcept
+        {
+            return _AlignUp(size, alignof(tDeallocate));
+        }
+
+        static tDeallocate* _Trailer(void* frame, std::size_t size) noexcept
+        {
+            return std::launder(reinterpret_cast<tDeallocate*>(static_cast<std::byte*>(frame) + _TrailerOffset(size)));
+        }
+
+        template<typename AllocatorT>
+        static constexpr std::size_t _AllocatorOffset(std::size_t size) noexcept
+        {
+            return _AlignUp(_TrailerOffset(size) + sizeof(tDeallocate), alignof(tBlockAllocator<AllocatorT>));
+        }
+
+        template<typename AllocatorT>
+        static constexpr std::size_t _BlocksCount(std::size_t size) noexcept
+        {
+            return _AlignUp(_AllocatorOffset<AllocatorT>(size) + sizeof(tBlockAllocator<AllocatorT>), sizeof(_Block))
+                   / sizeof(_Block);
+        }
+
+        template<typename AllocatorT>
+        static tBlockAllocator<AllocatorT>* _StoredAllocator(void* frame, std::size_t size) noexcept
+        {
+            return std::launder(reinterpret_cast<tBlockAllocator<AllocatorT>*>(
+                static_cast<std::byte*>(frame) + _AllocatorOffset<AllocatorT>(size)));
+        }
+
+        template<typename AllocatorT>
+        static void* _AllocateWith(std::size_t size, AllocatorT const& allocator)
+        {
+            static_assert(alignof(tBlockAllocator<AllocatorT>) <= alignof(_Block), "The allocator is overaligned!");
+
+            tBlockAllocator<AllocatorT> blockAllocator(allocator);
+            void* const frame = std::allocator_traits<tBlockAllocator<AllocatorT>>::allocate(
+                blockAllocator, _BlocksCount<AllocatorT>(size));
+            ::new (_Trailer(frame, size)) tDeallocate(&_DeallocateWith<AllocatorT>);
+            ::new (_StoredAllocator<AllocatorT>(frame, size)) tBlockAllocator<AllocatorT>(std::move(blockAllocator));
+            return frame;
+        }
+
+        template<typename AllocatorT>
+        static void _DeallocateWith(void* frame, std::size_t size) noexcept
+        {
+            tBlockAllocator<AllocatorT>* const stored = _StoredAllocator<AllocatorT>(frame, size);
+            tBlockAllocator<AllocatorT> blockAllocator(std::move(*stored));
+            stored->~tBlockAllocator<AllocatorT>();
+            std::allocator_traits<tBlockAllocator<AllocatorT>>::deallocate(
+                blockAllocator, static_cast<_Block*>(frame), _BlocksCount<AllocatorT>(size));
+        }
+    };
+} /// end namespace Darkness::Concurrency::Coroutine
@@ -9,63 +9,33 @@
 
 #pragma once
 
+#include <Darkness/Concurrency/Coroutine/BucketJobQueue.hpp>
+#include <Darkness/Concurrency/Coroutine/Task.hpp>
+#include <Darkness/Concurrency/Tracer.hpp>
+
 #include <concepts>
 #include <coroutine>
 #include <functional>
 #include <queue>
 #include <utility>
+#include <vector>
 
 namespace Darkness::Concurrency::Coroutine {
-    class Task final
-    {
-    public:
-        struct promise_type final
-        {
-            constexpr std::suspend_always initial_suspend() noexcept
-            {
-                return {};
-            }
-
-            constexpr std::suspend_always final_suspend() noexcept
-            {
-                return {};
-            }
-
-            Task get_return_object()
-            {
-                return std::coroutine_handle<promise_type>::from_promise(*this);
-            }
-
-            constexpr void return_void()
-            {}
-
-            constexpr void unhandled_exception()
-            {}
-        };
-
-    public:
-        constexpr Task(std::coroutine_handle<promise_type> handle) noexcept
-            : m_Handle { handle }
-        {
-        }
-
-        std::coroutine_handle<promise_type> get_handle() noexcept
-        {
-            return m_Handle;
-        }
-
-    private:
-        std::coroutine_handle<promise_type> m_Handle;
-    };
-
     template<typename PriorityT = int>
         requires std::integral<PriorityT>
     using Job = std::pair<PriorityT, std::coroutine_handle<>>;
 
+    /// @brief The default job queue of PriorityQueueScheduler: a binary heap, O(log n) per push and pop.
+    template<typename PriorityT, typename ComparatorT>
+    using HeapJobQueue = std::priority_queue<Job<PriorityT>, std::vector<Job<PriorityT>>, ComparatorT>;
+
+    /// @param JobQueueT The job queue with the std::priority_queue interface: HeapJobQueue for any priorities
+    ///        or BucketJobQueue for O(1) operations on priorities in [0, 255].
     template<
         typename PriorityT = int
         , typename UpdaterT = std::identity
-        , typename ComparatorT = std::ranges::less>
+        , typename ComparatorT = std::ranges::less
+        , template<typename, typename> typename JobQueueT = HeapJobQueue>
     requires
     std::invocable<decltype(UpdaterT()), PriorityT>
     && std::predicate<decltype(ComparatorT()), Job<PriorityT>, Job<PriorityT>>
@@ -75,11 +45,30 @@ namespace Darkness::Concurrency::Coroutine {
         using tPriority = PriorityT;
 
     private:
-        using tJob = Job<tPriority>;
-        using tJobQueueContainer = std::vector<tJob>;
-        using tJobQueue = std::priority_queue<tJob, tJobQueueContainer, ComparatorT>;
+        using tJobQueue = JobQueueT<tPriority, ComparatorT>;
 
     public:
+        PriorityQueueScheduler() = default;
+
+        /// @short Coroutines which were not scheduled are destroyed.
+        ~PriorityQueueScheduler()
+        {
+            while (!m_JobQueue.empty())
+            {
+                m_JobQueue.top().second.destroy();
+                m_JobQueue.pop();
+            }
+        }
+
+        PriorityQueueScheduler(PriorityQueueScheduler const&) = delete;
+
+        PriorityQueueScheduler(PriorityQueueScheduler&&) = delete;
+
+        PriorityQueueScheduler& operator=(PriorityQueueScheduler const&) = delete;
+
+        PriorityQueueScheduler& operator=(PriorityQueueScheduler&&) = delete;
+
+        /// @param task The scheduler takes the ownership and destroys the coroutine when it is done.
         void AddTask(tPriority priority, std::coroutine_handle<> task)
         {
             m_JobQueue.emplace(priority, task);
@@ -88,11 +77,19 @@ namespace Darkness::Concurrency::Coroutine {
         void Schedule()
         {
             UpdaterT updater = {};
+#if defined(Darkness_Concurrency_TRACE)
+            static Tracer::tNameId const traceNameId = Tracer::Instance().Intern("PriorityQueueScheduler");
+#endif /// Darkness_Concurrency_TRACE
             while (!m_JobQueue.empty())
             {
                 auto [priority, task] = m_JobQueue.top();
                 m_JobQueue.pop();
-                task.resume();
+                {
+#if defined(Darkness_Concurrency_TRACE)
+                    TraceScope const traceScope(traceNameId, eTraceCategory::Scheduler);
+#endif /// Darkness_Concurrency_TRACE
+                    task.resume();
+                }
 
                 if (task.done())
                 {
@@ -112,7 +109,7 @@ namespace Darkness::Concurrency::Coroutine {
 
 /**
  * @code
-    Task createTask(const std::string& name)
+    Task<> createTask(const std::string& name)
     {
         std::cout << name << " start\n";
 
@@ -140,9 +137,9 @@ namespace Darkness::Concurrency::Coroutine {
 
         PriorityQueueScheduler<> scheduler1;
 
-        scheduler1.AddTask(0, createTask(taskA).get_handle());
-        scheduler1.AddTask(1, createTask(taskB).get_handle());
-        scheduler1.AddTask(2, createTask(taskC).get_handle());
+        scheduler1.AddTask(0, createTask(taskA).release());
+        scheduler1.AddTask(1, createTask(taskB).release());
+        scheduler1.AddTask(2, createTask(taskC).release());
 
         scheduler1.Schedule();
 
@@ -150,12 +147,22 @@ namespace Darkness::Concurrency::Coroutine {
 
         PriorityQueueScheduler<int, decltype([](int a) { return a - 1; })> scheduler2;
 
-        scheduler2.AddTask(0, createTask(taskA).get_handle());
-        scheduler2.AddTask(1, createTask(taskB).get_handle());
-        scheduler2.AddTask(2, createTask(taskC).get_handle());
+        scheduler2.AddTask(0, createTask(taskA).release());
+        scheduler2.AddTask(1, createTask(taskB).release());
+        scheduler2.AddTask(2, createTask(taskC).release());
 
         scheduler2.Schedule();
 
+        std::cout << '\n';
+
+        PriorityQueueScheduler<int, std::identity, std::ranges::less, BucketJobQueue> scheduler3;
+
+        scheduler3.AddTask(0, createTask(taskA).release());
+        scheduler3.AddTask(1, createTask(taskB).release());
+        scheduler3.AddTask(2, createTask(taskC).release());
+
+        scheduler3.Schedule();
+
         std::cout << std::endl;
     }
 */
@@ -0,0 +1,112 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    ScheduleOn.hpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Implementation of ScheduleOn. Awaitable which moves the coroutine to the worker of a queue.
+///          @short co_await ScheduleOn(queue) posts the continuation into the queue and the coroutine is resumed
+///                 by the queue worker. The continuation is a lambda which holds only the coroutine handle, so it
+///                 is stored inline in tTask without a heap allocation.
+
+#pragma once
+
+#include <Darkness/Concurrency/IQueue.hpp>
+#include <Darkness/Concurrency/QueueHandle.hpp>
+
+#include <coroutine>
+#include <utility>
+
+namespace Darkness::Concurrency::Coroutine {
+    template<typename TargetT>
+    class ScheduleOnAwaitable final
+    {
+    public:
+        explicit ScheduleOnAwaitable(TargetT target, tPostLocation location) noexcept
+            : m_Target(std::move(target))
+              , m_Location(location)
+        {
+        }
+
+        [[nodiscard]] constexpr bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> continuation)
+        {
+            /// @short The coroutine may be resumed by the worker before Post returns, so the awaitable which lives
+            ///        in the coroutine frame is not touched after a successful Post.
+            m_IsScheduled = true;
+            bool const isPosted = _Post(m_Target, [continuation] { continuation.resume(); }, m_Location);
+            if (!isPosted)
+            {
+                m_IsScheduled = false;
+            }
+
+            return isPosted;
+        }
+
+        /// @return false if the queue does not exist anymore, then the coroutine continues on the current thread.
+        bool await_resume() const noexcept
+        {
+            return m_IsScheduled;
+        }
+
+    private:
+        static bool _Post(IQueue* queue, tTask&& continuation, tPostLocation location)
+        {
+            queue->Post(std::move(continuation), location);
+            return true;
+        }
+
+        static bool _Post(tQueueWeakPtr const& queue, tTask&& continuation, tPostLocation location)
+        {
+            if (auto const locked = queue.lock())
+            {
+                locked->Post(std::move(continuation), location);
+                return true;
+            }
+
+            return false;
+        }
+
+        static bool _Post(QueueHandle const& queue, tTask&& continuation, tPostLocation location)
+        {
+            return queue.Post(std::move(continuation), location);
+        }
+
+    private:
+        TargetT m_Target;
+
+        /// @short The place of co_await, the continuation is attributed to it by TaskProfiler.
+        [[no_unique_address]] tPostLocation m_Location;
+        bool m_IsScheduled { false };
+    };
+
+    /// @brief Resumes the coroutine on the worker of the queue.
+    /// @warning If the queue is stopped or destroyed with the continuation pending, the coroutine is never resumed.
+    [[nodiscard]] inline ScheduleOnAwaitable<IQueue*> ScheduleOn(
+        IQueue& queue, tPostLocation location = tPostLocation::current()) noexcept
+    {
+        return ScheduleOnAwaitable<IQueue*>(&queue, location);
+    }
+
+    /// @brief Resumes the coroutine on the worker of the queue which is obtained from QueueManager.
+    ///        If the queue does not exist anymore, co_await returns false and the coroutine continues on the
+    ///        current thread.
+    [[nodiscard]] inline ScheduleOnAwaitable<tQueueWeakPtr> ScheduleOn(
+        tQueueWeakPtr queue, tPostLocation location = tPostLocation::current()) noexcept
+    {
+        return ScheduleOnAwaitable<tQueueWeakPtr>(std::move(queue), location);
+    }
+
+    /// @brief Resumes the coroutine on the worker of the queue which is addressed by the handle.
+    ///        If the queue is forgotten, co_await returns false and the coroutine continues on the current thread.
+    [[nodiscard]] inline ScheduleOnAwaitable<QueueHandle> ScheduleOn(
+        QueueHandle queue, tPostLocation location = tPostLocation::current()) noexcept
+    {
+        return ScheduleOnAwaitable<QueueHandle>(queue, location);
+    }
+} /// end namespace Darkness::Concurrency::Coroutine
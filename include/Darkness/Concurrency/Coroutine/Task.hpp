@@ -0,0 +1,307 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    Task.hpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Implementation of @class Task. Lazy coroutine which returns a value or propagates an exception.
+///          @short The task starts when it is awaited (or resumed by a scheduler). Awaiting and finishing use
+///                 symmetric transfer, so chains of awaits of any length run in constant stack. The task owns
+///                 the coroutine frame and destroys it, unless the ownership is released. Frames are allocated
+///                 by PooledFrameAllocation.
+/// @warning GCC turns the symmetric transfer into a tail call only with optimizations enabled (and without
+///          sanitizers), so debug builds may still overflow the stack on very deep chains.
+
+#pragma once
+
+#include <Darkness/Concurrency/Coroutine/FramePool.hpp>
+
+#include <cassert>
+#include <concepts>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace Darkness::Concurrency::Coroutine {
+    template<typename T>
+    class _TaskPromiseResult
+    {
+        using tStored = std::conditional_t<std::is_reference_v<T>, std::remove_reference_t<T>*, T>;
+
+    public:
+        template<typename U = T>
+            requires std::convertible_to<U&&, T>
+        void return_value(U&& value) noexcept(std::is_nothrow_constructible_v<T, U&&>)
+        {
+            if constexpr (std::is_reference_v<T>)
+            {
+                T reference = std::forward<U>(value);
+                m_Result.template emplace<_Value>(std::addressof(reference));
+            }
+            else
+            {
+                m_Result.template emplace<_Value>(std::forward<U>(value));
+            }
+        }
+
+        void unhandled_exception() noexcept
+        {
+            m_Result.template emplace<_Exception>(std::current_exception());
+        }
+
+        decltype(auto) GetResult() &
+        {
+            _RethrowIfFailed();
+            if constexpr (std::is_reference_v<T>)
+            {
+                return static_cast<T>(*std::get<_Value>(m_Result));
+            }
+            else
+            {
+                return static_cast<T&>(std::get<_Value>(m_Result));
+            }
+        }
+
+        T GetResult() &&
+        {
+            _RethrowIfFailed();
+            if constexpr (std::is_reference_v<T>)
+            {
+                return static_cast<T>(*std::get<_Value>(m_Result));
+            }
+            else
+            {
+                return std::move(std::get<_Value>(m_Result));
+            }
+        }
+
+    private:
+        void _RethrowIfFailed() const
+        {
+            if (m_Result.index() == _Exception)
+            {
+                std::rethrow_exception(std::get<_Exception>(m_Result));
+            }
+        }
+
+    private:
+        static constexpr std::size_t const _Value = 1;
+        static constexpr std::size_t const _Exception = 2;
+
+        std::variant<std::monostate, tStored, std::exception_ptr> m_Result;
+    };
+
+    template<>
+    class _TaskPromiseResult<void>
+    {
+    public:
+        constexpr void return_void() noexcept
+        {}
+
+        void unhandled_exception() noexcept
+        {
+            m_Exception = std::current_exception();
+        }
+
+        void GetResult() const
+        {
+            if (m_Exception)
+            {
+                std::rethrow_exception(m_Exception);
+            }
+        }
+
+    private:
+        std::exception_ptr m_Exception;
+    };
+
+    template<typename T = void>
+    class [[nodiscard]] Task final
+    {
+    public:
+        struct promise_type;
+
+        using tHandle = std::coroutine_handle<promise_type>;
+
+    private:
+        struct _FinalAwaiter final
+        {
+            [[nodiscard]] constexpr bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            /// @short Transfers the execution to the awaiting coroutine. Without one (the task is resumed by
+            ///        a scheduler) the control returns to the resumer and the frame stays suspended till destruction.
+            [[nodiscard]] std::coroutine_handle<> await_suspend(tHandle finished) const noexcept
+            {
+                std::coroutine_handle<> const continuation = finished.promise().m_Continuation;
+                return continuation ? continuation : std::noop_coroutine();
+            }
+
+            constexpr void await_resume() const noexcept
+            {}
+        };
+
+        template<bool IsRvalueV>
+        struct _Awaiter final
+        {
+            [[nodiscard]] bool await_ready() const
+            {
+                assert(handle && "Bad logic! An empty task is awaited.");
+                if (!handle)
+                {
+                    throw std::logic_error("Darkness::Concurrency::Coroutine::Task::co_await: the task is empty!");
+                }
+
+                return handle.done();
+            }
+
+            [[nodiscard]] tHandle await_suspend(std::coroutine_handle<> awaiting) const noexcept
+            {
+                handle.promise().m_Continuation = awaiting;
+                return handle;
+            }
+
+            decltype(auto) await_resume() const
+            {
+                if constexpr (IsRvalueV)
+                {
+                    return std::move(handle.promise()).GetResult();
+                }
+                else
+                {
+                    return handle.promise().GetResult();
+                }
+            }
+
+            tHandle handle;
+        };
+
+    public:
+        struct promise_type final : _TaskPromiseResult<T>, PooledFrameAllocation
+        {
+            Task get_return_object() noexcept
+            {
+                return Task(tHandle::from_promise(*this));
+            }
+
+            constexpr std::suspend_always initial_suspend() const noexcept
+            {
+                return {};
+            }
+
+            constexpr _FinalAwaiter final_suspend() const noexcept
+            {
+                return {};
+            }
+
+        private:
+            friend _FinalAwaiter;
+            template<bool>
+            friend struct _Awaiter;
+
+            std::coroutine_handle<> m_Continuation;
+        };
+
+    public:
+        constexpr Task() noexcept = default;
+
+        constexpr explicit Task(tHandle handle) noexcept
+            : m_Handle { handle }
+        {
+        }
+
+        Task(Task&& other) noexcept
+            : m_Handle { std::exchange(other.m_Handle, {}) }
+        {
+        }
+
+        Task& operator=(Task&& other) noexcept
+        {
+            if (this != &other)
+            {
+                _Destroy();
+                m_Handle = std::exchange(other.m_Handle, {});
+            }
+
+            return *this;
+        }
+
+        Task(Task const&) = delete;
+
+        Task& operator=(Task const&) = delete;
+
+        ~Task()
+        {
+            _Destroy();
+        }
+
+        /// @brief Returns the handle. The task keeps the ownership.
+        [[nodiscard]] tHandle get_handle() const& noexcept
+        {
+            return m_Handle;
+        }
+
+        /// @short A temporary task destroys the frame at the end of the expression, use release() instead.
+        tHandle get_handle() && = delete;
+
+        /// @brief Returns the handle and gives up the ownership. The caller should destroy the frame,
+        ///        PriorityQueueScheduler does it when the coroutine is done.
+        [[nodiscard]] tHandle release() noexcept
+        {
+            return std::exchange(m_Handle, {});
+        }
+
+        [[nodiscard]] bool IsValid() const noexcept
+        {
+            return static_cast<bool>(m_Handle);
+        }
+
+        [[nodiscard]] bool IsDone() const noexcept
+        {
+            return m_Handle && m_Handle.done();
+        }
+
+        /// @brief Returns the result of the finished task or rethrows its exception.
+        [[nodiscard]] decltype(auto) GetResult() &
+        {
+            return m_Handle.promise().GetResult();
+        }
+
+        [[nodiscard]] decltype(auto) GetResult() &&
+        {
+            return std::move(m_Handle.promise()).GetResult();
+        }
+
+        /// @brief Starts the task and suspends the awaiting coroutine till the task is finished.
+        ///        An awaited temporary task gives its result by value.
+        /// @warning An empty task (default constructed or moved from) can not be awaited, std::logic_error is thrown.
+        [[nodiscard]] _Awaiter<false> operator co_await() const& noexcept
+        {
+            return { m_Handle };
+        }
+
+        [[nodiscard]] _Awaiter<true> operator co_await() const&& noexcept
+        {
+            return { m_Handle };
+        }
+
+    private:
+        void _Destroy() noexcept
+        {
+            if (m_Handle)
+            {
+                std::exchange(m_Handle, {}).destroy();
+            }
+        }
+
+    private:
+        tHandle m_Handle;
+    };
+} /// end namespace Darkness::Concurrency::Coroutine
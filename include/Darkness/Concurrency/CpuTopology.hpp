@@ -0,0 +1,85 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    CpuTopology.hpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Declaration of @class CpuTopology. Physical cores, last level caches and NUMA nodes of the machine.
+///          @short On Linux the topology is read from sysfs. Elsewhere, or if sysfs is not available, every
+///                 logical CPU is considered a separate core of one cache and one node.
+
+#pragma once
+
+#include <Darkness/Concurrency/ThreadAttributes.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Darkness::Concurrency {
+    struct LogicalCpu final
+    {
+        std::size_t id = 0;
+
+        /// @brief The index in CpuTopology::GetPhysicalCores().
+        std::size_t physicalCore = 0;
+
+        /// @brief The index in CpuTopology::GetLastLevelCaches().
+        std::size_t lastLevelCache = 0;
+
+        /// @brief The index in CpuTopology::GetNumaNodes().
+        std::size_t numaNode = 0;
+    };
+
+    class CpuTopology final
+    {
+    public:
+        /// @brief Returns the topology of this machine. It is read once.
+        [[nodiscard]] static CpuTopology const& Instance();
+
+        /// @brief Reads the topology from the sysfs tree under root.
+        [[nodiscard]] static CpuTopology Read(std::string const& root = "/sys/devices/system");
+
+        /// @brief Returns the online logical CPUs ordered by id.
+        [[nodiscard]] std::vector<LogicalCpu> const& GetCpus() const noexcept
+        {
+            return m_Cpus;
+        }
+
+        /// @brief Returns the logical CPUs (hyper-threads) of every physical core.
+        [[nodiscard]] std::vector<tCpuSet> const& GetPhysicalCores() const noexcept
+        {
+            return m_PhysicalCores;
+        }
+
+        /// @brief Returns the logical CPUs which share every last level cache.
+        [[nodiscard]] std::vector<tCpuSet> const& GetLastLevelCaches() const noexcept
+        {
+            return m_LastLevelCaches;
+        }
+
+        [[nodiscard]] std::vector<tCpuSet> const& GetNumaNodes() const noexcept
+        {
+            return m_NumaNodes;
+        }
+
+        /// @brief Returns the CPUs of the pool worker by the placement. Empty for eWorkerPlacement::None.
+        [[nodiscard]] tCpuSet const& GetWorkerCpuSet(eWorkerPlacement placement, std::size_t workerIndex) const;
+
+        /// @brief Returns the attributes of the pool worker. If the attributes have a CPU set, the groups of the
+        ///        placement are intersected with it, the empty intersections are skipped and the workers are
+        ///        distributed over the rest. So the worker never leaves the CPU set of the attributes.
+        [[nodiscard]] ThreadAttributes PlaceWorker(ThreadAttributes attributes, eWorkerPlacement placement
+                                                   , std::size_t workerIndex) const;
+
+    private:
+        [[nodiscard]] std::vector<tCpuSet> const& _GetGroups(eWorkerPlacement placement) const noexcept;
+
+    private:
+        std::vector<LogicalCpu> m_Cpus;
+        std::vector<tCpuSet> m_PhysicalCores;
+        std::vector<tCpuSet> m_LastLevelCaches;
+        std::vector<tCpuSet> m_NumaNodes;
+    };
+} /// end namespace Darkness::Concurrency
@@ -9,10 +9,18 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <mutex>
 #include <condition_variable>
 
 namespace Darkness::Concurrency {
+    /// @brief The wait strategy tag for Event which selects the lock-free realization based on std::atomic::wait.
+    struct AtomicWaitStrategy final
+    {
+    };
+
     template<
         typename StateT = bool
         , StateT _StateSignaledDefaultValue = true
@@ -108,5 +116,146 @@ namespace Darkness::Concurrency {
         tMonitorWaitStrategy m_MonitorWaitStrategy;
     };
 
+    /// @brief The realization of Event based on std::atomic::wait/notify of the state word.
+    ///        @short Set without waiters is one atomic store and a load of the waiters count. Wait on the signaled
+    ///               event is one atomic load. Untimed waiters sleep on the state word. Timed waiters have no atomic
+    ///               equivalent, so they wait on a condition variable under MutexT which is touched by Set only
+    ///               while such waiters exist.
+    template<
+        typename StateT
+        , StateT _StateSignaledDefaultValue
+        , StateT _StateNonSignaledValue
+        , typename MutexT
+        , typename StatusForWaitStrategyT
+        , template<typename> class LockStrategyT
+            >
+    class Event<StateT, _StateSignaledDefaultValue, _StateNonSignaledValue, MutexT, AtomicWaitStrategy
+                , StatusForWaitStrategyT, LockStrategyT>
+    {
+        using tWaitersCount = std::uint32_t;
+
+    public:
+        using tState = StateT;
+        using tMonitor = MutexT;
+        using tMonitorWaitStrategy = std::condition_variable_any;
+        using tMonitorLockStrategy = LockStrategyT<tMonitor>;
+
+        static_assert(std::atomic<tState>::is_always_lock_free, "The state should be a lock-free atomic!");
+
+    public:
+        Event() noexcept = default;
+
+        explicit Event(tState initValue) noexcept
+            : m_State(initValue)
+        {
+        }
+
+        [[nodiscard]] tState GetState() const noexcept
+        {
+            return m_State.load(std::memory_order_acquire);
+        }
+
+        [[nodiscard]] tState Wait(bool reset = false)
+        {
+            tState state = m_State.load(std::memory_order_acquire);
+            while (true)
+            {
+                if (StateNonSignaled == state)
+                {
+                    m_Waiters.fetch_add(1, std::memory_order_seq_cst);
+                    while (StateNonSignaled == (state = m_State.load(std::memory_order_seq_cst)))
+                    {
+                        m_State.wait(StateNonSignaled, std::memory_order_seq_cst);
+                    }
+
+                    m_Waiters.fetch_sub(1, std::memory_order_relaxed);
+                }
+
+                if (!reset || m_State.compare_exchange_weak(state, StateNonSignaled, std::memory_order_acq_rel))
+                {
+                    return state;
+                }
+            }
+        }
+
+        template<typename DurationT>
+        [[nodiscard]] tState WaitFor(DurationT period, bool reset = false)
+        {
+            tState state = m_State.load(std::memory_order_acquire);
+            if (StateNonSignaled != state)
+            {
+                if (!reset || m_State.compare_exchange_strong(state, StateNonSignaled, std::memory_order_acq_rel))
+                {
+                    return state;
+                }
+            }
+
+            auto const deadline = std::chrono::steady_clock::now() + period;
+
+            tMonitorLockStrategy lock(m_Monitor);
+            m_TimedWaiters.fetch_add(1, std::memory_order_seq_cst);
+            while (true)
+            {
+                state = m_State.load(std::memory_order_seq_cst);
+                if (StateNonSignaled != state)
+                {
+                    if (reset && !m_State.compare_exchange_strong(state, StateNonSignaled
+                                                                  , std::memory_order_acq_rel))
+                    {
+                        continue;
+                    }
+
+                    break;
+                }
+
+                if (std::cv_status::timeout == m_MonitorWaitStrategy.wait_until(lock, deadline))
+                {
+                    state = m_State.load(std::memory_order_acquire);
+                    break;
+                }
+            }
+
+            m_TimedWaiters.fetch_sub(1, std::memory_order_relaxed);
+            return state;
+        }
+
+        void Set(tState setValue = StateSignaledDefault)
+        {
+            m_State.store(setValue, std::memory_order_seq_cst);
+
+            if (m_Waiters.load(std::memory_order_seq_cst) != 0)
+            {
+                m_State.notify_all();
+            }
+
+            if (m_TimedWaiters.load(std::memory_order_seq_cst) != 0)
+            {
+                {
+                    tMonitorLockStrategy const lock(m_Monitor);
+                }
+
+                m_MonitorWaitStrategy.notify_all();
+            }
+        }
+
+        void Reset()
+        {
+            m_State.store(StateNonSignaled, std::memory_order_release);
+        }
+
+    public:
+        static constexpr tState const StateSignaledDefault = _StateSignaledDefaultValue;
+        static constexpr tState const StateNonSignaled = _StateNonSignaledValue;
+
+    private:
+        std::atomic<tState> m_State { StateNonSignaled };
+        std::atomic<tWaitersCount> m_Waiters { 0 };
+        std::atomic<tWaitersCount> m_TimedWaiters { 0 };
+        tMonitor m_Monitor;
+        tMonitorWaitStrategy m_MonitorWaitStrategy;
+    };
+
     using tEvent = Event<>;
+
+    using tAtomicEvent = Event<bool, true, false, std::mutex, AtomicWaitStrategy>;
 } /// namespace Darkness::Concurrency
@@ -10,9 +10,11 @@
 #pragma once
 
 #include <Darkness/Concurrency/Types.hpp>
+#include <Darkness/Concurrency/QueueMetrics.hpp>
 
 #include <thread>
 #include <memory>
+#include <span>
 #include <stop_token>
 #include <string>
 
@@ -27,15 +29,36 @@ namespace Darkness::Concurrency {
 
         [[nodiscard]] virtual eAsyncState GetState() const noexcept = 0;
 
-        virtual void Post(tTask&& task) = 0;
+        /// @param location The place of the post for TaskProfiler. Is captured automatically.
+        virtual void Post(tTask&& task, tPostLocation location = tPostLocation::current()) = 0;
 
-        virtual void Post(tTask const& task) = 0;
+        /// @brief Posts all tasks with one synchronization and one wake-up of the worker.
+        /// @short The tasks are moved from.
+        virtual void PostBatch(std::span<tTask> tasks, tPostLocation location = tPostLocation::current()) = 0;
 
         [[nodiscard]] virtual std::thread::id GetWorkThreadId() const noexcept = 0;
 
         [[nodiscard]] virtual std::string const& GetName() const noexcept = 0;
+
+        /// @brief Returns the snapshot of the runtime metrics. The counters are read one by one, so the snapshot
+        ///        of a busy queue is not exactly consistent.
+        [[nodiscard]] virtual QueueMetrics GetMetrics() const noexcept = 0;
     };
 
     using tQueuePtr = std::shared_ptr<IQueue>;
     using tQueueWeakPtr = std::weak_ptr<IQueue>;
+
+    /// @brief Posts all tasks into the queue which is obtained from QueueManager. The weak pointer is locked once.
+    /// @return false if the queue does not exist anymore.
+    inline bool PostBatch(tQueueWeakPtr const& queue, std::span<tTask> tasks
+                          , tPostLocation location = tPostLocation::current())
+    {
+        if (auto const locked = queue.lock())
+        {
+            locked->PostBatch(tasks, location);
+            return true;
+        }
+
+        return false;
+    }
 } /// end namespace Darkness::Concurrency
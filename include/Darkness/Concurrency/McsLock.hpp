@@ -0,0 +1,52 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    McsLock.hpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Declaration of @class McsLock
+///          @short Fair queue lock (Mellor-Crummey and Scott). Every waiter spins on the flag of its own node which
+///                 lives on its own cache line, and the lock is handed over in FIFO order. The nodes are taken from
+///                 a thread-local pool, so the interface is the same as of Spinlock.
+
+#pragma once
+
+#include <Darkness/Concurrency/Types.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace Darkness::Concurrency {
+    class McsLock
+    {
+    public:
+        struct Node;
+
+    public:
+        McsLock() noexcept;
+
+        McsLock(McsLock const&) noexcept = delete;
+
+        McsLock(McsLock&&) noexcept = delete;
+
+        McsLock& operator=(McsLock const&) noexcept = delete;
+
+        McsLock& operator=(McsLock&&) noexcept = delete;
+
+        void lock() noexcept;
+
+        [[nodiscard]] bool try_lock() noexcept;
+
+        /// @warning Should be called from the thread which owns the lock.
+        void unlock() noexcept;
+
+    private:
+        /// @short The number of checks of the own flag before parking.
+        static constexpr std::uint32_t const _SpinRounds = 128;
+
+    private:
+        alignas(CacheLineSize) std::atomic<Node*> m_Tail { nullptr };
+        Node* m_Owner { nullptr }; /// Is accessed only by the owner of the lock.
+    };
+} /// namespace Darkness::Concurrency
@@ -0,0 +1,55 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    QueueHandle.hpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Declaration of @class QueueHandle. Lightweight copyable reference to a queue of QueueManager.
+///          @short The handle is an index and a generation in the queue table. Posting through it does not touch
+///                 shared_ptr reference counters: the queue is protected by a per-thread hazard slot while the
+///                 task is posted. After the queue is forgotten the generation does not match and Post fails.
+
+#pragma once
+
+#include <Darkness/Concurrency/Types.hpp>
+
+#include <cstdint>
+#include <span>
+
+namespace Darkness::Concurrency {
+    class QueueHandle final
+    {
+        friend class QueueTable;
+
+    public:
+        QueueHandle() noexcept = default;
+
+        /// @brief Checks that the handle refers to some queue. The queue can be forgotten already.
+        [[nodiscard]] bool IsValid() const noexcept
+        {
+            return m_Generation != 0;
+        }
+
+        /// @brief Posts the task into the queue.
+        /// @return false if the queue is forgotten. The task is not moved from then.
+        bool Post(tTask&& task, tPostLocation location = tPostLocation::current()) const;
+
+        /// @brief Posts all tasks into the queue at once.
+        /// @return false if the queue is forgotten.
+        bool PostBatch(std::span<tTask> tasks, tPostLocation location = tPostLocation::current()) const;
+
+        friend bool operator==(QueueHandle const&, QueueHandle const&) noexcept = default;
+
+    private:
+        QueueHandle(std::uint32_t index, std::uint32_t generation) noexcept
+            : m_Index(index)
+              , m_Generation(generation)
+        {
+        }
+
+    private:
+        std::uint32_t m_Index { 0 };
+        std::uint32_t m_Generation { 0 };
+    };
+} /// end namespace Darkness::Concurrency
@@ -6,36 +6,63 @@
 /// @license Distributed under the Boost Software License, Version 1.0.
 ///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 /// @brief   Declaration of @class QueueManager. Singleton for manipulations with IQueue objects.
+///          @short Lookups of existing queues take no lock and make no allocation: they read an immutable snapshot
+///                 of the registry which is replaced on creation and forgetting of queues.
 
 #pragma once
 
 #include <Darkness/Concurrency/IQueue.hpp>
+#include <Darkness/Concurrency/QueueHandle.hpp>
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace Darkness::Concurrency {
     class QueueManager final
     {
         class _Impl;
 
+    public:
+        using tNamedQueueMetrics = std::vector<std::pair<std::string, QueueMetrics>>;
+
     public:
         ~QueueManager();
 
         [[nodiscard]] static QueueManager const& Instance() noexcept;
 
         [[nodiscard]] tQueueWeakPtr CreateOrGetBackgroundQueueByName(
-            std::string const& name, tExceptionHandler const& exceptionHandler = {}) const;
+            std::string_view name, tExceptionHandler const& exceptionHandler = {}
+            , QueueOptions const& options = {}) const;
 
-        [[nodiscard]] bool IsExists(std::string const& name) const noexcept;
+        /// @brief Creates or gets the queue which is serviced by workersCount threads with work stealing.
+        ///        Zero workersCount means the number of hardware threads.
+        /// @short The execution order of tasks of such queue is not guaranteed.
+        [[nodiscard]] tQueueWeakPtr CreateOrGetThreadPoolQueueByName(
+            std::string_view name, std::size_t workersCount = 0
+            , tExceptionHandler const& exceptionHandler = {}, QueueOptions const& options = {}) const;
+
+        [[nodiscard]] bool IsExists(std::string_view name) const noexcept;
+
+        /// @brief Returns the handle of the existing queue for posting without weak_ptr::lock.
+        /// @return The invalid handle if the queue does not exist or the queue table is full.
+        [[nodiscard]] QueueHandle GetHandleByName(std::string_view name) const noexcept;
 
         [[nodiscard]] bool IsMainExists() const noexcept;
 
-        [[nodiscard]] tQueueWeakPtr CreateOrGetMainQueue(tExceptionHandler const& exceptionHandler = {}) const;
+        [[nodiscard]] tQueueWeakPtr CreateOrGetMainQueue(tExceptionHandler const& exceptionHandler = {}
+                                                         , QueueOptions const& options = {}) const;
 
-        void ForgetByName(std::string const& name) const;
+        void ForgetByName(std::string_view name) const;
 
         void ForgetMainQueue() const;
 
         void KillAndForgetAll() const;
 
+        /// @brief Returns the metrics of all existing queues sorted by name.
+        [[nodiscard]] tNamedQueueMetrics CollectMetrics() const;
+
     private:
         QueueManager() noexcept;
 
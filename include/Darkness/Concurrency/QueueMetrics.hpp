@@ -0,0 +1,61 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    QueueMetrics.hpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Declaration of @struct QueueMetrics. Snapshot of the runtime metrics of a queue.
+///          @short The metrics are collected only when the library is built with Darkness_Concurrency_Queue_METRICS
+///                 (the CMake option Enable_Queue_METRICS), otherwise the snapshot is empty and isEnabled is false.
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace Darkness::Concurrency {
+    /// @brief Histogram of durations with power-of-two buckets.
+    /// @short The bucket i counts durations in [2^i, 2^(i+1)) nanoseconds, the bucket 0 also counts zero.
+    struct LatencyHistogram final
+    {
+        static constexpr std::size_t const BucketsCount = 64;
+
+        /// @brief Returns the upper bound of the bucket which contains the fraction of the samples.
+        ///        The result overestimates the real percentile by less than twice.
+        [[nodiscard]] std::chrono::nanoseconds GetPercentile(double fraction) const noexcept;
+
+        [[nodiscard]] std::chrono::nanoseconds GetMean() const noexcept;
+
+        /// @brief Returns the index of the bucket for the duration.
+        [[nodiscard]] static std::size_t GetBucketIndex(std::uint64_t nanoseconds) noexcept;
+
+        std::array<std::uint64_t, BucketsCount> buckets {};
+        std::uint64_t count = 0;
+        std::chrono::nanoseconds total { 0 };
+    };
+
+    struct QueueMetrics final
+    {
+        /// @brief false if the library is built without the metrics.
+        bool isEnabled = false;
+
+        /// @brief The number of tasks which are posted but not started yet.
+        std::uint64_t depth = 0;
+        std::uint64_t peakDepth = 0;
+
+        std::uint64_t enqueuedCount = 0;
+        std::uint64_t executedCount = 0;
+
+        /// @brief The number of tasks which were dropped by the stop of the queue.
+        std::uint64_t droppedCount = 0;
+
+        /// @brief The time from posting till the start of execution.
+        LatencyHistogram waitTime;
+
+        /// @brief The time of execution.
+        LatencyHistogram serviceTime;
+    };
+} /// end namespace Darkness::Concurrency
@@ -0,0 +1,71 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    RWSpinlock.hpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Declaration of @class RWSpinlock. Reader-writer lock for read-mostly data.
+///          @short The readers are counted in cache-line padded stripes and every thread always uses the same
+///                 stripe, so the readers of different threads do not share a cache line. A writer closes the
+///                 entrance for new readers first (writer preference) and then waits for all stripes to drain.
+
+#pragma once
+
+#include <Darkness/Concurrency/Types.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace Darkness::Concurrency {
+    class RWSpinlock
+    {
+    public:
+        RWSpinlock() noexcept;
+
+        RWSpinlock(RWSpinlock const&) noexcept = delete;
+
+        RWSpinlock(RWSpinlock&&) noexcept = delete;
+
+        RWSpinlock& operator=(RWSpinlock const&) noexcept = delete;
+
+        RWSpinlock& operator=(RWSpinlock&&) noexcept = delete;
+
+        void lock() noexcept;
+
+        [[nodiscard]] bool try_lock() noexcept;
+
+        void unlock() noexcept;
+
+        void lock_shared() noexcept;
+
+        [[nodiscard]] bool try_lock_shared() noexcept;
+
+        void unlock_shared() noexcept;
+
+    private:
+        using tCounter = std::uint32_t;
+
+        struct alignas(CacheLineSize) _ReadersStripe final
+        {
+            std::atomic<tCounter> count { 0 };
+        };
+
+        [[nodiscard]] bool _TryAcquireWriter() noexcept;
+
+        [[nodiscard]] std::atomic<tCounter>& _GetReadersCount() noexcept;
+
+        void _WaitForWriter() noexcept;
+
+        void _WaitForReaders() noexcept;
+
+        static constexpr std::size_t const _StripesCount = 32;
+        static constexpr std::uint32_t const _SpinRounds = 128;
+
+    private:
+        alignas(CacheLineSize) std::atomic<tCounter> m_Writer { 0 };
+        std::atomic<tCounter> m_ParkedCount { 0 };
+        std::array<_ReadersStripe, _StripesCount> m_Readers {};
+    };
+} /// namespace Darkness::Concurrency
@@ -0,0 +1,162 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    Seqlock.hpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Implementation of @class Seqlock. Holder of a small trivially copyable value for read-mostly data.
+///          @short Readers never write shared memory: they copy the value and retry if the sequence number was
+///                 changed by a writer meanwhile. Writers are serialized by the odd sequence number. The value is
+///                 stored as atomic words, so the racy copy of a reader is not a data race.
+
+#pragma once
+
+#include <Darkness/Concurrency/Types.hpp>
+#include <Darkness/Concurrency/Utilities.hpp>
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace Darkness::Concurrency {
+    template<typename T>
+    class Seqlock final
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "The value should be trivially copyable!");
+
+        using tSequence = std::uint32_t;
+        using tWord = std::uintptr_t;
+
+        static constexpr std::size_t const _WordsCount = (sizeof(T) + sizeof(tWord) - 1) / sizeof(tWord);
+
+        using tWords = std::array<std::atomic<tWord>, _WordsCount>;
+        using tBuffer = std::array<tWord, _WordsCount>;
+
+    public:
+        using value_type = T;
+
+    public:
+        Seqlock() noexcept(std::is_nothrow_default_constructible_v<T>)
+            : Seqlock(T {})
+        {
+        }
+
+        explicit Seqlock(T const& value) noexcept
+        {
+            _Write(value);
+        }
+
+        Seqlock(Seqlock const&) = delete;
+
+        Seqlock(Seqlock&&) = delete;
+
+        Seqlock& operator=(Seqlock const&) = delete;
+
+        Seqlock& operator=(Seqlock&&) = delete;
+
+        /// @brief Returns a consistent copy of the value. Lock-free for the readers, retries while a write is active.
+        [[nodiscard]] T Load() const noexcept
+        {
+            tBuffer buffer;
+            while (true)
+            {
+                tSequence const before = m_Sequence.load(std::memory_order_acquire);
+                if ((before & 1) == 0)
+                {
+                    for (std::size_t index = 0; index < _WordsCount; ++index)
+                    {
+                        buffer[index] = m_Words[index].load(std::memory_order_relaxed);
+                    }
+
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (m_Sequence.load(std::memory_order_relaxed) == before)
+                    {
+                        break;
+                    }
+                }
+
+                CpuRelax();
+            }
+
+            return _FromBuffer(buffer);
+        }
+
+        /// @brief Replaces the value.
+        void Store(T const& value) noexcept
+        {
+            tSequence const sequence = _LockWriter();
+            _Write(value);
+            m_Sequence.store(sequence + 2, std::memory_order_release);
+        }
+
+        /// @brief Replaces the value by the result of updater(oldValue). Concurrent writers are serialized.
+        /// @warning The updater should be short and should not throw, the readers spin while it is executed.
+        template<typename UpdaterT>
+        void Update(UpdaterT&& updater) noexcept
+        {
+            tSequence const sequence = _LockWriter();
+            _Write(updater(_Read()));
+            m_Sequence.store(sequence + 2, std::memory_order_release);
+        }
+
+        /// @brief Returns the number of completed writes.
+        [[nodiscard]] tSequence GetVersion() const noexcept
+        {
+            return m_Sequence.load(std::memory_order_acquire) / 2;
+        }
+
+    private:
+        /// @return The even sequence number before the write.
+        tSequence _LockWriter() noexcept
+        {
+            tSequence sequence = m_Sequence.load(std::memory_order_relaxed);
+            while ((sequence & 1) != 0
+                   || !m_Sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire))
+            {
+                CpuRelax();
+                sequence = m_Sequence.load(std::memory_order_relaxed);
+            }
+
+            /// @short The odd number should be visible before any word of the new value.
+            std::atomic_thread_fence(std::memory_order_release);
+            return sequence;
+        }
+
+        void _Write(T const& value) noexcept
+        {
+            tBuffer buffer {};
+            std::memcpy(buffer.data(), &value, sizeof(T));
+            for (std::size_t index = 0; index < _WordsCount; ++index)
+            {
+                m_Words[index].store(buffer[index], std::memory_order_relaxed);
+            }
+        }
+
+        [[nodiscard]] T _Read() const noexcept
+        {
+            tBuffer buffer;
+            for (std::size_t index = 0; index < _WordsCount; ++index)
+            {
+                buffer[index] = m_Words[index].load(std::memory_order_relaxed);
+            }
+
+            return _FromBuffer(buffer);
+        }
+
+        [[nodiscard]] static T _FromBuffer(tBuffer const& buffer) noexcept
+        {
+            std::array<std::byte, sizeof(T)> bytes;
+            std::memcpy(bytes.data(), buffer.data(), sizeof(T));
+            return std::bit_cast<T>(bytes);
+        }
+
+    private:
+        alignas(CacheLineSize) std::atomic<tSequence> m_Sequence { 0 };
+        tWords m_Words {};
+    };
+} /// end namespace Darkness::Concurrency
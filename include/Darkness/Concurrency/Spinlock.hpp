@@ -6,10 +6,14 @@
 /// @license Distributed under the Boost Software License, Version 1.0.
 ///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 /// @brief   Declaration of @class Spinlock
+///          @short Test-and-test-and-set lock with exponential backoff. The contender spins on a plain load, so
+///                 the cache line is not bounced between the cores, and after the spin budget it parks on the lock
+///                 word by std::atomic::wait, so a preempted holder does not make the waiters burn their cores.
 
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 
 namespace Darkness::Concurrency {
     class Spinlock
@@ -27,9 +31,26 @@ namespace Darkness::Concurrency {
 
         void lock() noexcept;
 
+        [[nodiscard]] bool try_lock() noexcept;
+
         void unlock() noexcept;
 
     private:
-        std::atomic_flag m_Flag;
+        void _LockContended() noexcept;
+
+    private:
+        enum _eState : std::uint32_t
+        {
+            _Unlocked = 0
+            , _Locked = 1
+            , _LockedWithParkedWaiters = 2
+        };
+
+        /// @short The number of backoff rounds before parking. The pause count doubles each round up to the maximum.
+        static constexpr std::uint32_t const _SpinRounds = 16;
+        static constexpr std::uint32_t const _MaxPausesPerRound = 64;
+
+    private:
+        std::atomic<std::uint32_t> m_State { _Unlocked };
     };
 } /// namespace Darkness::Concurrency
@@ -0,0 +1,151 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    TaskProfiler.hpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Declaration of @class TaskProfiler. Sampling profiler which attributes the execution time of tasks to
+///          the places where they were posted.
+///          @short Queues capture the place of Post (tPostLocation) and feed the profiler only when the library is
+///                 built with Darkness_Concurrency_TASK_PROFILER (the CMake option Enable_TASK_PROFILER) and the
+///                 profiler is enabled at runtime. Every thread aggregates its samples separately, the report merges
+///                 them.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <source_location>
+#include <string>
+#include <vector>
+
+namespace Darkness::Concurrency {
+    /// @brief The aggregated statistics of the tasks which were posted from one place.
+    /// @short The counts and times are estimated: every sampled value is multiplied by the sampling period at the
+    ///        time the sample was taken.
+    struct TaskSiteStatistics final
+    {
+        std::string fileName;
+        std::string functionName;
+        std::uint32_t line = 0;
+
+        std::uint64_t samplesCount = 0;
+        std::uint64_t estimatedCount = 0;
+
+        /// @brief The CPU time of the executing thread. Is the wall time on systems without per-thread CPU clocks.
+        std::chrono::nanoseconds estimatedCpuTime { 0 };
+        std::chrono::nanoseconds estimatedWallTime { 0 };
+
+        /// @brief The longest sampled execution.
+        std::chrono::nanoseconds maxWallTime { 0 };
+    };
+
+    class TaskProfiler final
+    {
+        class _Impl;
+
+    public:
+        /// @brief A measurement of one task. Is empty if the task is not sampled.
+        class Sample final
+        {
+            friend class TaskProfiler;
+
+        public:
+            [[nodiscard]] bool IsTaken() const noexcept
+            {
+                return m_Weight != 0;
+            }
+
+        private:
+            std::chrono::nanoseconds m_CpuStart { 0 };
+            std::chrono::steady_clock::time_point m_WallStart {};
+
+            /// @brief The number of tasks the sample stands for, the sampling period when it was taken.
+            std::uint32_t m_Weight { 0 };
+        };
+
+        using tReport = std::vector<TaskSiteStatistics>;
+
+    public:
+        ~TaskProfiler();
+
+        TaskProfiler(TaskProfiler const&) = delete;
+
+        TaskProfiler(TaskProfiler&&) = delete;
+
+        TaskProfiler& operator=(TaskProfiler const&) = delete;
+
+        TaskProfiler& operator=(TaskProfiler&&) = delete;
+
+        [[nodiscard]] static TaskProfiler& Instance();
+
+        /// @brief Turns the sampling on or off. Is off by default.
+        void Enable(bool isEnabled) noexcept;
+
+        [[nodiscard]] bool IsEnabled() const noexcept
+        {
+            return m_IsEnabled.load(std::memory_order_relaxed);
+        }
+
+        /// @brief Every period-th task of a thread is measured on average. One measures every task.
+        /// @short The intervals between samples are random, so periodic posting patterns do not hide some places.
+        ///        A sample reads the CPU clock of the thread twice, which is a system call on most systems.
+        void SetSamplingPeriod(std::uint32_t period) noexcept;
+
+        [[nodiscard]] std::uint32_t GetSamplingPeriod() const noexcept;
+
+        /// @brief Starts the measurement of a task if it is its turn on the current thread.
+        [[nodiscard]] Sample StartSample() noexcept;
+
+        /// @brief Finishes the measurement and accounts it to the place of the post.
+        void FinishSample(Sample const& sample, std::source_location const& location) noexcept;
+
+        /// @brief Returns the statistics of all places sorted by the estimated CPU time, the most expensive first.
+        [[nodiscard]] tReport GetReport() const;
+
+        /// @brief Writes the top of the report as a table.
+        void WriteReport(std::ostream& stream, std::size_t maxCount = 20) const;
+
+        /// @brief Forgets the collected samples.
+        void Reset();
+
+    private:
+        TaskProfiler();
+
+    private:
+        std::atomic<bool> m_IsEnabled { false };
+        std::unique_ptr<_Impl> m_Impl;
+    };
+
+    /// @brief Measures the execution of a task from the construction till the destruction.
+    class TaskProfileScope final
+    {
+    public:
+        explicit TaskProfileScope(std::source_location const& location) noexcept
+            : m_Location(location)
+              , m_Sample(TaskProfiler::Instance().StartSample())
+        {
+        }
+
+        ~TaskProfileScope()
+        {
+            if (m_Sample.IsTaken())
+            {
+                TaskProfiler::Instance().FinishSample(m_Sample, m_Location);
+            }
+        }
+
+        TaskProfileScope(TaskProfileScope const&) = delete;
+
+        TaskProfileScope& operator=(TaskProfileScope const&) = delete;
+
+    private:
+        std::source_location const& m_Location;
+        TaskProfiler::Sample const m_Sample;
+    };
+} /// end namespace Darkness::Concurrency
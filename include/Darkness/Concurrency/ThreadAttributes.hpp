@@ -0,0 +1,71 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    ThreadAttributes.hpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Declaration of @struct ThreadAttributes. CPU affinity, scheduling class and nice value of the threads
+///          of queues and timers.
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace Darkness::Concurrency {
+    /// @brief The indexes of logical CPUs.
+    using tCpuSet = std::vector<std::size_t>;
+
+    enum class eSchedulingPolicy
+    {
+        /// @brief The policy of the creating thread is kept.
+        Inherit,
+
+        /// @brief SCHED_OTHER, the default time-sharing policy.
+        Other,
+
+        /// @brief SCHED_FIFO, real-time first-in first-out policy. Usually requires CAP_SYS_NICE.
+        Fifo
+    };
+
+    /// @brief Placement of the workers of a thread pool queue by the CPU topology, see CpuTopology.
+    enum class eWorkerPlacement
+    {
+        None,
+
+        /// @brief The worker i is bound to the logical CPUs of the physical core i (round robin).
+        PerPhysicalCore,
+
+        /// @brief The worker i is bound to the CPUs which share the last level cache i (round robin).
+        PerLastLevelCache,
+
+        /// @brief The worker i is bound to the CPUs of the NUMA node i (round robin).
+        PerNumaNode
+    };
+
+    struct ThreadAttributes final
+    {
+        [[nodiscard]] bool IsEmpty() const noexcept
+        {
+            return cpuSet.empty() && schedulingPolicy == eSchedulingPolicy::Inherit && !nice.has_value();
+        }
+
+        /// @brief The CPUs the thread may run on. Empty means no restriction.
+        tCpuSet cpuSet {};
+
+        eSchedulingPolicy schedulingPolicy { eSchedulingPolicy::Inherit };
+
+        /// @brief The static priority of the Fifo policy, 1 (lowest) - 99 (highest). Is ignored by Other.
+        int priority { 0 };
+
+        /// @brief The nice value of the thread, -20 (highest priority) - 19 (lowest). Is kept if empty.
+        std::optional<int> nice {};
+    };
+
+    /// @brief Applies the attributes to the current thread.
+    /// @return false if some attribute is not applied, for example because of missing privileges.
+    ///         The other attributes are applied anyway.
+    bool SetCurrentThreadAttributes(ThreadAttributes const& attributes) noexcept;
+} /// end namespace Darkness::Concurrency
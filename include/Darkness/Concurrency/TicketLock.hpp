@@ -0,0 +1,61 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    TicketLock.hpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Declaration of @class TicketLock
+///          @short Fair (partitioned) ticket lock. The contenders take tickets and get the lock strictly in FIFO
+///                 order. The grant of a ticket is published into its own cache-line padded slot, so every waiter
+///                 spins on its own line and the release wakes only the next waiter.
+
+#pragma once
+
+#include <Darkness/Concurrency/Types.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace Darkness::Concurrency {
+    class TicketLock
+    {
+    public:
+        TicketLock() noexcept;
+
+        TicketLock(TicketLock const&) noexcept = delete;
+
+        TicketLock(TicketLock&&) noexcept = delete;
+
+        TicketLock& operator=(TicketLock const&) noexcept = delete;
+
+        TicketLock& operator=(TicketLock&&) noexcept = delete;
+
+        void lock() noexcept;
+
+        [[nodiscard]] bool try_lock() noexcept;
+
+        void unlock() noexcept;
+
+    private:
+        using tTicket = std::uint32_t;
+
+        struct alignas(CacheLineSize) _Slot final
+        {
+            std::atomic<tTicket> grant { 0 };
+        };
+
+        /// @short More waiters than slots share the slots, then they are woken together.
+        static constexpr std::size_t const _SlotsCount = 64;
+
+        /// @short The number of checks of the own slot before parking.
+        static constexpr std::uint32_t const _SpinRounds = 128;
+
+    private:
+        alignas(CacheLineSize) std::atomic<tTicket> m_NextTicket { 0 };
+        alignas(CacheLineSize) std::atomic<tTicket> m_ServedTicket { 0 };
+        std::atomic<std::uint32_t> m_ParkedCount { 0 };
+        std::array<_Slot, _SlotsCount> m_Slots {};
+    };
+} /// namespace Darkness::Concurrency
@@ -0,0 +1,105 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    TimerService.hpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Declaration of @class TimerService. Shared service which executes many timers on one thread.
+///          @short Timers are kept in a hierarchical timing wheel (4 levels of 256 slots), so scheduling and
+///                 cancellation cost O(1). A fired task is executed on the service thread or is posted into
+///                 the chosen queue.
+
+#pragma once
+
+#include <Darkness/Concurrency/IQueue.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace Darkness::Concurrency {
+    class TimerService final
+    {
+        class _Impl;
+
+    public:
+        using tDuration = std::chrono::nanoseconds;
+        using tDelayProvider = std::function<tDuration()>;
+        using tTimerId = std::uint64_t;
+
+    public:
+        /// @brief Constructs a TimerService object and starts its thread.
+        /// @param name The name of the service thread into the OS. Maybe empty.
+        /// @param resolution The duration of one tick of the wheel. Timers are fired with this granularity.
+        explicit TimerService(std::string name = "", tDuration resolution = std::chrono::milliseconds(1));
+
+        /// @short Pending timers are dropped. A task running on the service thread is waited for.
+        ~TimerService();
+
+        TimerService(TimerService const&) = delete;
+
+        TimerService(TimerService&&) = delete;
+
+        TimerService& operator=(TimerService const&) = delete;
+
+        TimerService& operator=(TimerService&&) = delete;
+
+        /// @brief Returns the default shared service.
+        [[nodiscard]] static std::shared_ptr<TimerService> const& Instance();
+
+        /// @brief Schedules a one-shot timer.
+        /// @param queue The queue for execution of the task. If empty, the task is executed on the service thread
+        ///        and should be short.
+        template<typename Representation, typename Period>
+        tTimerId ScheduleOnce(std::chrono::duration<Representation, Period> const& delay, tTask task
+                              , tQueueWeakPtr queue = {}, tExceptionHandler exceptionHandler = {})
+        {
+            return _Schedule(std::chrono::duration_cast<tDuration>(delay), {}, std::move(task), std::move(queue)
+                             , std::move(exceptionHandler), eTimerMode::FixedDelay, eMissedTickPolicy::Skip);
+        }
+
+        /// @brief Schedules a periodic timer with the constant period.
+        /// @short If the previous execution posted into the queue is not finished yet, the tick is skipped.
+        template<typename Representation, typename Period>
+        tTimerId SchedulePeriodic(std::chrono::duration<Representation, Period> const& period, tTask task
+                                  , tQueueWeakPtr queue = {}, tExceptionHandler exceptionHandler = {}
+                                  , eTimerMode mode = eTimerMode::FixedDelay
+                                  , eMissedTickPolicy missedTickPolicy = eMissedTickPolicy::Skip)
+        {
+            auto const duration = std::chrono::duration_cast<tDuration>(period);
+            return _Schedule(duration, [duration] { return duration; }, std::move(task), std::move(queue)
+                             , std::move(exceptionHandler), mode, missedTickPolicy);
+        }
+
+        /// @brief Schedules a periodic timer. The delay before each tick is provided by delayProvider.
+        /// @param mode In the fixed-rate mode the ticks are aligned to absolute deadlines, the provided delay is
+        ///        the distance between two neighbour deadlines.
+        tTimerId SchedulePeriodic(tDelayProvider delayProvider, tTask task
+                                  , tQueueWeakPtr queue = {}, tExceptionHandler exceptionHandler = {}
+                                  , eTimerMode mode = eTimerMode::FixedDelay
+                                  , eMissedTickPolicy missedTickPolicy = eMissedTickPolicy::Skip);
+
+        /// @brief Cancels the timer. Waits for the running execution of its task unless it is called from the task.
+        /// @return false if the timer is not found (already fired one-shot timer or wrong id).
+        bool Cancel(tTimerId id);
+
+        /// @brief Returns the number of scheduled timers.
+        [[nodiscard]] std::size_t GetTimersCount() const;
+
+    private:
+        tTimerId _Schedule(tDuration firstDelay, tDelayProvider delayProvider, tTask task
+                           , tQueueWeakPtr queue, tExceptionHandler exceptionHandler
+                           , eTimerMode mode, eMissedTickPolicy missedTickPolicy);
+
+    public:
+        static constexpr tTimerId const InvalidTimerId = 0;
+
+    private:
+        std::unique_ptr<_Impl> m_Impl;
+    };
+
+    using tTimerServicePtr = std::shared_ptr<TimerService>;
+} /// namespace Darkness::Concurrency
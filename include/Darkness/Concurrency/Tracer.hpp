@@ -0,0 +1,137 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    Tracer.hpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Declaration of @class Tracer. Records the timeline of tasks and dumps it as Chrome trace-event JSON
+///          which is opened by chrome://tracing or ui.perfetto.dev.
+///          @short Every thread writes into its own ring buffer without a lock, the oldest events are overwritten.
+///                 Queues, timers and schedulers record their events only when the library is built with
+///                 Darkness_Concurrency_TRACE (the CMake option Enable_TRACE) and the tracer is enabled at runtime.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace Darkness::Concurrency {
+    enum class eTraceCategory : std::uint8_t
+    {
+        Queue,
+        Timer,
+        Scheduler,
+        User
+    };
+
+    class Tracer final
+    {
+        class _Impl;
+
+    public:
+        /// @brief The id of an interned name.
+        using tNameId = std::uint32_t;
+
+        /// @brief Links the post of a task with the start of its execution. Zero means no link.
+        using tFlowId = std::uint64_t;
+
+    public:
+        ~Tracer();
+
+        Tracer(Tracer const&) = delete;
+
+        Tracer(Tracer&&) = delete;
+
+        Tracer& operator=(Tracer const&) = delete;
+
+        Tracer& operator=(Tracer&&) = delete;
+
+        [[nodiscard]] static Tracer& Instance();
+
+        /// @brief Turns the recording on or off. Is off by default.
+        void Enable(bool isEnabled) noexcept;
+
+        [[nodiscard]] bool IsEnabled() const noexcept
+        {
+            return m_IsEnabled.load(std::memory_order_relaxed);
+        }
+
+        /// @brief Sets the number of events in the ring of a thread. Is rounded up to a power of two.
+        /// @short Is applied to the threads which record their first event after the call.
+        void SetThreadBufferCapacity(std::size_t eventsCount) noexcept;
+
+        /// @brief Returns the id of the name. The same name always has the same id.
+        /// @short Takes a lock, so names should be interned once and not on every event.
+        [[nodiscard]] tNameId Intern(std::string_view name);
+
+        /// @brief Gives the name to the current thread into the trace. Is called by SetCurrentThreadName.
+        void SetCurrentThreadName(std::string_view name);
+
+        /// @brief Records the post of a task.
+        /// @return The flow id to pass into RecordBegin of the task or NoFlowId if the tracer is disabled.
+        [[nodiscard]] tFlowId RecordPost(tNameId nameId, eTraceCategory category) noexcept;
+
+        /// @brief Records the start of a slice on the current thread.
+        /// @return false if the tracer is disabled, then the matching RecordEnd should not be called.
+        bool RecordBegin(tNameId nameId, eTraceCategory category, tFlowId flowId = NoFlowId) noexcept;
+
+        void RecordEnd(tNameId nameId, eTraceCategory category) noexcept;
+
+        void RecordInstant(tNameId nameId, eTraceCategory category) noexcept;
+
+        /// @brief Forgets the recorded events and the rings of finished threads.
+        void Clear();
+
+        /// @brief Writes the recorded events as Chrome trace-event JSON. Can be called while threads are recording.
+        void WriteChromeTrace(std::ostream& stream) const;
+
+        /// @return false if the file can not be written.
+        bool WriteChromeTrace(std::string const& path) const;
+
+    public:
+        static constexpr tFlowId const NoFlowId = 0;
+
+    private:
+        Tracer();
+
+    private:
+        std::atomic<bool> m_IsEnabled { false };
+        std::unique_ptr<_Impl> m_Impl;
+    };
+
+    /// @brief Records a slice of the current thread from the construction till the destruction.
+    class TraceScope final
+    {
+    public:
+        explicit TraceScope(Tracer::tNameId nameId, eTraceCategory category
+                            , Tracer::tFlowId flowId = Tracer::NoFlowId) noexcept
+            : m_NameId(nameId)
+              , m_Category(category)
+              , m_IsRecorded(Tracer::Instance().RecordBegin(nameId, category, flowId))
+        {
+        }
+
+        ~TraceScope()
+        {
+            if (m_IsRecorded)
+            {
+                Tracer::Instance().RecordEnd(m_NameId, m_Category);
+            }
+        }
+
+        TraceScope(TraceScope const&) = delete;
+
+        TraceScope& operator=(TraceScope const&) = delete;
+
+    private:
+        Tracer::tNameId const m_NameId;
+        eTraceCategory const m_Category;
+        bool const m_IsRecorded;
+    };
+} /// end namespace Darkness::Concurrency
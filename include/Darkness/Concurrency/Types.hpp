@@ -8,13 +8,61 @@
 
 #pragma once
 
+#include <Darkness/Concurrency/ThreadAttributes.hpp>
+#include <Darkness/Concurrency/UniqueTask.hpp>
+
 #include <functional>
 #include <exception>
+#include <cstddef>
+
+#if defined(Darkness_Concurrency_TASK_PROFILER)
+#include <source_location>
+#endif /// Darkness_Concurrency_TASK_PROFILER
+
+/// @short The size of the inline buffer of tTask. Lambdas which capture up to this number of bytes are posted without
+///        a heap allocation.
+#if !defined(Darkness_Concurrency_Task_InlineSize)
+#define Darkness_Concurrency_Task_InlineSize 56
+#endif /// Darkness_Concurrency_Task_InlineSize
 
 namespace Darkness::Concurrency {
-    using tTask = std::function<void()>;
+    using tTask = UniqueTask<Darkness_Concurrency_Task_InlineSize>;
     using tExceptionHandler = std::function<void(std::exception_ptr)>;
 
+#if defined(Darkness_Concurrency_TASK_PROFILER)
+    /// @brief The place of the post of a task. The execution time of the task is attributed to it by TaskProfiler.
+    using tPostLocation = std::source_location;
+#else
+    /// @brief The place of the post is not captured. The empty parameter costs nothing.
+    struct NoPostLocation final
+    {
+        [[nodiscard]] static consteval NoPostLocation current() noexcept
+        {
+            return {};
+        }
+    };
+
+    using tPostLocation = NoPostLocation;
+#endif /// Darkness_Concurrency_TASK_PROFILER
+
+    /// @short Used for separation of hot data of concurrent primitives by cache lines.
+    constexpr std::size_t const CacheLineSize = 64;
+
+    /// @brief Settings of a queue. Are applied only when the queue is created.
+    struct QueueOptions final
+    {
+        /// @short The maximum number of tasks which the worker takes from the queue at once and executes back to
+        ///        back. Use 1 for latency-sensitive queues.
+        std::size_t maxBatchSize = 64;
+
+        /// @brief The attributes of the worker threads. Are not applied to the main queue, it runs on the thread
+        ///        of its creator.
+        ThreadAttributes threadAttributes {};
+
+        /// @brief The placement of the workers of a thread pool queue, see CpuTopology::PlaceWorker.
+        eWorkerPlacement workerPlacement { eWorkerPlacement::None };
+    };
+
     enum class eAsyncState
     {
         Free
@@ -22,4 +70,19 @@ namespace Darkness::Concurrency {
         , Stopping
         , Stopped
     };
+
+    /// @brief How the next tick of a periodic timer is calculated.
+    enum class eTimerMode
+    {
+        FixedDelay /// The delay is counted from the end of the previous tick, so the task time causes a drift.
+        , FixedRate /// The ticks are aligned to absolute deadlines start + N * delay, there is no drift.
+    };
+
+    /// @brief What a fixed-rate timer does with the ticks which were missed because of a long task or a wake up delay.
+    enum class eMissedTickPolicy
+    {
+        Skip /// The missed ticks are dropped, the next tick is the next aligned deadline in the future.
+        , CatchUp /// All missed ticks are executed back to back.
+        , Coalesce /// The missed ticks are merged into one immediate tick, then the aligned ticks are continued.
+    };
 } /// end namespace Darkness::Concurrency
@@ -0,0 +1,209 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    UniqueTask.hpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Implementation of @class UniqueTask. Move-only type-erased void() callable with an inline buffer.
+///          @short Callables which fit into the buffer and are nothrow movable are stored without a heap allocation,
+///                 other ones are stored on the heap. Unlike std::function the callable may be move-only.
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Darkness::Concurrency {
+    template<std::size_t InlineSizeV>
+    class UniqueTask final
+    {
+        struct _VTable final
+        {
+            void (* invoke)(void* storage);
+
+            void (* relocate)(void* destination, void* source) noexcept;
+
+            void (* destroy)(void* storage) noexcept;
+        };
+
+        template<typename F>
+        static constexpr bool _IsInline = sizeof(F) <= InlineSizeV
+                                          && alignof(F) <= alignof(std::max_align_t)
+                                          && std::is_nothrow_move_constructible_v<F>;
+
+        template<typename F>
+        struct _InlineVTable final
+        {
+            static F* _Get(void* storage) noexcept
+            {
+                return std::launder(static_cast<F*>(storage));
+            }
+
+            static constexpr _VTable const value {
+                [](void* storage) {
+                    std::invoke(*_Get(storage));
+                }
+                , [](void* destination, void* source) noexcept {
+                    ::new (destination) F(std::move(*_Get(source)));
+                    _Get(source)->~F();
+                }
+                , [](void* storage) noexcept {
+                    _Get(storage)->~F();
+                }
+            };
+        };
+
+        template<typename F>
+        struct _HeapVTable final
+        {
+            static F*& _Get(void* storage) noexcept
+            {
+                return *std::launder(static_cast<F**>(storage));
+            }
+
+            static constexpr _VTable const value {
+                [](void* storage) {
+                    std::invoke(*_Get(storage));
+                }
+                , [](void* destination, void* source) noexcept {
+                    ::new (destination) F*(_Get(source));
+                }
+                , [](void* storage) noexcept {
+                    delete _Get(storage);
+                }
+            };
+        };
+
+        template<typename F>
+        static bool _IsNull(F const& callable) noexcept
+        {
+            if constexpr (std::is_pointer_v<F> || std::is_member_pointer_v<F>)
+            {
+                return callable == nullptr;
+            }
+            else if constexpr (std::is_same_v<F, std::function<void()>>)
+            {
+                return !callable;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+    public:
+        static constexpr std::size_t const InlineSize = InlineSizeV;
+
+        static_assert(InlineSizeV >= sizeof(void*), "The inline buffer should be able to hold a pointer!");
+
+    public:
+        UniqueTask() noexcept = default;
+
+        UniqueTask(std::nullptr_t) noexcept
+        {
+        }
+
+        template<typename F>
+            requires (!std::is_same_v<std::remove_cvref_t<F>, UniqueTask>)
+                     && std::invocable<std::decay_t<F>&>
+                     && std::constructible_from<std::decay_t<F>, F>
+        UniqueTask(F&& callable)
+        {
+            using tCallable = std::decay_t<F>;
+
+            if (_IsNull(callable))
+            {
+                return;
+            }
+
+            if constexpr (_IsInline<tCallable>)
+            {
+                ::new (static_cast<void*>(m_Storage)) tCallable(std::forward<F>(callable));
+                m_VTable = &_InlineVTable<tCallable>::value;
+            }
+            else
+            {
+                ::new (static_cast<void*>(m_Storage)) tCallable*(new tCallable(std::forward<F>(callable)));
+                m_VTable = &_HeapVTable<tCallable>::value;
+            }
+        }
+
+        UniqueTask(UniqueTask&& other) noexcept
+            : m_VTable(std::exchange(other.m_VTable, nullptr))
+        {
+            if (m_VTable)
+            {
+                m_VTable->relocate(m_Storage, other.m_Storage);
+            }
+        }
+
+        UniqueTask& operator=(UniqueTask&& other) noexcept
+        {
+            if (this != &other)
+            {
+                _Reset();
+                m_VTable = std::exchange(other.m_VTable, nullptr);
+                if (m_VTable)
+                {
+                    m_VTable->relocate(m_Storage, other.m_Storage);
+                }
+            }
+
+            return *this;
+        }
+
+        UniqueTask& operator=(std::nullptr_t) noexcept
+        {
+            _Reset();
+            return *this;
+        }
+
+        UniqueTask(UniqueTask const&) = delete;
+
+        UniqueTask& operator=(UniqueTask const&) = delete;
+
+        ~UniqueTask()
+        {
+            _Reset();
+        }
+
+        void operator()()
+        {
+            if (!m_VTable)
+            {
+                throw std::bad_function_call();
+            }
+
+            m_VTable->invoke(m_Storage);
+        }
+
+        [[nodiscard]] explicit operator bool() const noexcept
+        {
+            return m_VTable != nullptr;
+        }
+
+        void swap(UniqueTask& other) noexcept
+        {
+            std::swap(*this, other);
+        }
+
+    private:
+        void _Reset() noexcept
+        {
+            if (m_VTable)
+            {
+                std::exchange(m_VTable, nullptr)->destroy(m_Storage);
+            }
+        }
+
+    private:
+        alignas(std::max_align_t) std::byte m_Storage[InlineSizeV];
+        _VTable const* m_VTable { nullptr };
+    };
+} /// end namespace Darkness::Concurrency
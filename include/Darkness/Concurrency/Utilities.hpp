@@ -15,7 +15,25 @@
 #include <thread>
 #include <exception>
 
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
 namespace Darkness::Concurrency {
+    /// @brief Hints the CPU that the caller spins in a busy-wait loop (pause/yield instruction).
+    inline void CpuRelax() noexcept
+    {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        asm volatile("yield" ::: "memory");
+#else
+        std::this_thread::yield();
+#endif
+    }
+
     void SetThreadName(std::string const& name, std::thread::native_handle_type handle);
 
     void SetCurrentThreadName(std::string const& name);
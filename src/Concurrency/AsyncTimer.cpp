@@ -8,9 +8,11 @@
 /// @brief   Implementation of @class AsyncTimer
 
 #include <Darkness/Concurrency/AsyncTimer.hpp>
+#include <Darkness/Concurrency/Tracer.hpp>
 #include <Darkness/Concurrency/Utilities.hpp>
 #include <Darkness/Common/Utilities.hpp>
 #include <Darkness/Common/ScopeExit.hpp>
+#include "TickDeadline.hpp"
 
 #include <thread>
 #include <mutex>
@@ -19,6 +21,7 @@
 #include <cassert>
 #include <iostream>
 #include <iomanip>
+#include <optional>
 #include <utility>
 #include <variant>
 
@@ -26,6 +29,7 @@ namespace Darkness::Concurrency {
     class AsyncTimer::_Impl final
     {
         using tUniquLock = std::unique_lock<std::mutex>;
+        using tClock = std::chrono::steady_clock;
 
         struct _Params final
         {
@@ -38,14 +42,32 @@ namespace Darkness::Concurrency {
                   , task { std::move(task) }
                   , exceptionHandler { std::move(exceptionHandler) }
                   , name { std::move(name) }
+#if defined(Darkness_Concurrency_TRACE)
+                  , traceNameId { Tracer::Instance().Intern(this->name.empty() ? "AsyncTimer" : this->name) }
+#endif /// Darkness_Concurrency_TRACE
             {
             }
 
+            /// @brief Executes the task of one tick.
+            void Tick()
+            {
+                if (task)
+                {
+#if defined(Darkness_Concurrency_TRACE)
+                    TraceScope const traceScope(traceNameId, eTraceCategory::Timer);
+#endif /// Darkness_Concurrency_TRACE
+                    task();
+                }
+            }
+
         public:
             tDelayProviderHolder delayProviderHolder;
             tTask task;
             tExceptionHandler exceptionHandler;
             std::string name;
+#if defined(Darkness_Concurrency_TRACE)
+            Tracer::tNameId traceNameId;
+#endif /// Darkness_Concurrency_TRACE
         };
 
         using tParamsOpt = std::optional<_Params>;
@@ -56,7 +78,7 @@ namespace Darkness::Concurrency {
             explicit _ExecutionContext(_Impl* self) noexcept
                 : condition {}
                   , mutex {}
-                  , thread([self](auto stopToken) { self->_Routine(stopToken); })
+                  , thread([self, this](auto stopToken) { self->_Routine(stopToken, *this); })
             {
             }
 
@@ -84,20 +106,33 @@ namespace Darkness::Concurrency {
 
         using tExecutionContextPtr = std::unique_ptr<_ExecutionContext>;
 
+        struct _LatenessAccumulator final
+        {
+            std::uint64_t count = 0;
+            tDurationDelay sum { 0 };
+            tDurationDelay min { 0 };
+            tDurationDelay max { 0 };
+            tDurationDelay last { 0 };
+        };
+
+        using tLatenessLock = std::lock_guard<std::mutex> const;
+
     public:
         _Impl() noexcept = default;
 
         explicit _Impl(tDurationDelayRuntimeProvider const& durationDelayRuntimeProvider, tTask task
-                       , std::string name, tExceptionHandler exceptionHandler) noexcept
+                       , std::string name, tExceptionHandler exceptionHandler, AsyncTimerOptions options) noexcept
             : m_Params(std::make_optional<_Params>(durationDelayRuntimeProvider, std::move(task)
                                                    , std::move(name), std::move(exceptionHandler)))
+              , m_Options(std::move(options))
         {
         }
 
         explicit _Impl(tDurationDelay const& durationDelay, tTask task
-                       , std::string name, tExceptionHandler exceptionHandler) noexcept
+                       , std::string name, tExceptionHandler exceptionHandler, AsyncTimerOptions options) noexcept
             : m_Params(std::make_optional<_Params>(durationDelay, std::move(task)
                                                    , std::move(name), std::move(exceptionHandler)))
+              , m_Options(std::move(options))
         {
         }
 
@@ -110,7 +145,10 @@ namespace Darkness::Concurrency {
 
         _Impl(_Impl&& other) noexcept
             : m_Params { std::move(other.m_Params) }
+              , m_Options { std::move(other.m_Options) }
               , m_ExecutionContext { std::move(other.m_ExecutionContext) }
+              , m_TimerId { std::exchange(other.m_TimerId, TimerService::InvalidTimerId) }
+              , m_Lateness { other._GetLatenessAccumulator() }
               , m_State { other.m_State.load() }
         {
             other.m_State = eAsyncState::Free;
@@ -123,7 +161,15 @@ namespace Darkness::Concurrency {
             if (this != &other)
             {
                 m_Params = std::move(other.m_Params);
+                m_Options = std::move(other.m_Options);
                 m_ExecutionContext = std::move(other.m_ExecutionContext);
+                m_TimerId = std::exchange(other.m_TimerId, TimerService::InvalidTimerId);
+                auto const lateness = other._GetLatenessAccumulator();
+                {
+                    tLatenessLock lock(m_LatenessAccess);
+                    m_Lateness = lateness;
+                }
+
                 m_State = other.m_State.load();
                 other.m_State = eAsyncState::Free;
             }
@@ -136,6 +182,29 @@ namespace Darkness::Concurrency {
             return m_State;
         }
 
+        [[nodiscard]] TimerLatenessStatistics _GetLatenessStatistics() const noexcept
+        {
+            auto const lateness = _GetLatenessAccumulator();
+
+            TimerLatenessStatistics statistics;
+            statistics.count = lateness.count;
+            statistics.min = lateness.min;
+            statistics.max = lateness.max;
+            statistics.last = lateness.last;
+            if (lateness.count != 0)
+            {
+                statistics.mean = lateness.sum / static_cast<tDurationDelay::rep>(lateness.count);
+            }
+
+            return statistics;
+        }
+
+        void _ResetLatenessStatistics() noexcept
+        {
+            tLatenessLock lock(m_LatenessAccess);
+            m_Lateness = {};
+        }
+
         void _Start() noexcept
         {
             switch (m_State)
@@ -144,6 +213,12 @@ namespace Darkness::Concurrency {
                 case eAsyncState::Free:
                 case eAsyncState::Stopped:
                 {
+                    if (m_Options.timerService)
+                    {
+                        _StartOnService();
+                        break;
+                    }
+
                     m_ExecutionContext = std::make_unique<_ExecutionContext>(this);
                     break;
                 }
@@ -181,6 +256,13 @@ namespace Darkness::Concurrency {
                 case eAsyncState::Busy:
                 {
                     m_State = eAsyncState::Stopping;
+                    if (m_Options.timerService)
+                    {
+                        m_Options.timerService->Cancel(std::exchange(m_TimerId, TimerService::InvalidTimerId));
+                        m_State = eAsyncState::Stopped;
+                        break;
+                    }
+
                     m_ExecutionContext->_Stop();
                     m_ExecutionContext.reset();
                     break;
@@ -198,17 +280,71 @@ namespace Darkness::Concurrency {
         }
 
     private:
-        void _Routine(std::stop_token stopToken) noexcept
+        void _StartOnService()
+        {
+            assert(m_Params && "Bad data!");
+
+            auto delayProvider = std::visit([](auto const& delayProviderHolder) -> TimerService::tDelayProvider {
+                using tCurrentDelayProvider = std::decay_t<decltype(delayProviderHolder)>;
+                if constexpr (std::is_same_v<tCurrentDelayProvider, tDurationDelayRuntimeProvider>)
+                {
+                    return delayProviderHolder;
+                }
+                else
+                {
+                    return [delayProviderHolder] { return delayProviderHolder; };
+                }
+            }, m_Params->delayProviderHolder);
+
+            m_State = eAsyncState::Busy;
+            m_TimerId = m_Options.timerService->SchedulePeriodic(std::move(delayProvider), [this] {
+                m_Params->Tick();
+            }, m_Options.dispatchQueue, m_Params->exceptionHandler, m_Options.mode, m_Options.missedTickPolicy);
+        }
+
+        void _RecordLateness(tDurationDelay lateness) noexcept
+        {
+            tLatenessLock lock(m_LatenessAccess);
+            if (m_Lateness.count == 0)
+            {
+                m_Lateness.min = m_Lateness.max = lateness;
+            }
+            else
+            {
+                m_Lateness.min = std::min(m_Lateness.min, lateness);
+                m_Lateness.max = std::max(m_Lateness.max, lateness);
+            }
+
+            ++m_Lateness.count;
+            m_Lateness.sum += lateness;
+            m_Lateness.last = lateness;
+        }
+
+        [[nodiscard]] _LatenessAccumulator _GetLatenessAccumulator() const noexcept
+        {
+            tLatenessLock lock(m_LatenessAccess);
+            return m_Lateness;
+        }
+
+        /// @short The context is passed explicitly because the thread starts before m_ExecutionContext is assigned.
+        void _Routine(std::stop_token stopToken, _ExecutionContext& executionContext) noexcept
         {
             assert(m_Params && "Bad data!");
-            assert(m_ExecutionContext && "Bad data!");
 
             if (!m_Params->name.empty())
             {
                 SetCurrentThreadName(m_Params->name);
             }
 
-            m_ExecutionContext->id = std::this_thread::get_id();
+            if (!m_Options.threadAttributes.IsEmpty() && !SetCurrentThreadAttributes(m_Options.threadAttributes))
+            {
+#if defined(Darkness_Concurrency_Timer_DEBUG)
+                std::cerr << "AsyncTimer: some thread attributes of the timer " << std::quoted(m_Params->name)
+                          << " are not applied!" << '\n';
+#endif /// Darkness_Concurrency_Timer_DEBUG
+            }
+
+            executionContext.id = std::this_thread::get_id();
             m_State = eAsyncState::Busy;
 
             Common::ScopeExit const scopeExit { [this] {
@@ -219,8 +355,9 @@ namespace Darkness::Concurrency {
 
             try
             {
-                tUniquLock lock(m_ExecutionContext->mutex);
+                tUniquLock lock(executionContext.mutex);
                 bool isStopped = false; /// For checking the false wake up...
+                auto grid = tClock::now(); /// The aligned deadline of the previous tick in the fixed-rate mode.
                 do
                 {
                     auto const delay = std::visit([this](auto&& delayProviderHolder) {
@@ -235,17 +372,32 @@ namespace Darkness::Concurrency {
                         }
                     }, m_Params->delayProviderHolder);
 
-                    isStopped = m_ExecutionContext->condition.wait_for(
-                        lock, delay, [&stopToken] {
-                            return stopToken.stop_requested();
-                        });
+                    auto const isStopRequested = [&stopToken] {
+                        return stopToken.stop_requested();
+                    };
 
-                    if (!isStopped || !stopToken.stop_requested())
+                    auto const deadline = m_Options.mode == eTimerMode::FixedRate
+                                          ? NextTickDeadline<tClock>(grid, delay, m_Options.missedTickPolicy
+                                                                     , tClock::now())
+                                          : tClock::now() + delay;
+
+                    isStopped = executionContext.condition.wait_until(lock, deadline - m_Options.spinWindow
+                                                                      , isStopRequested);
+                    if (!isStopped)
                     {
-                        if (m_Params->task)
+                        /// @short The OS oversleeps, so the rest of the delay is spun out.
+                        while (tClock::now() < deadline && !stopToken.stop_requested())
                         {
-                            m_Params->task();
+                            CpuRelax();
                         }
+
+                        isStopped = stopToken.stop_requested();
+                        _RecordLateness(tClock::now() - deadline);
+                    }
+
+                    if (!isStopped || !stopToken.stop_requested())
+                    {
+                        m_Params->Tick();
                     }
 
                     if (stopToken.stop_requested())
@@ -273,7 +425,7 @@ namespace Darkness::Concurrency {
                 }
 #else
                 /// 2) Stop the thread and call the exception handler.
-                m_ExecutionContext->thread.request_stop();
+                executionContext.thread.request_stop();
                 m_IsStopped = true;
 
                 if (exceptionPtr && m_Params->exceptionHandler)
@@ -287,14 +439,19 @@ namespace Darkness::Concurrency {
 
     private:
         tParamsOpt m_Params { std::nullopt };
+        AsyncTimerOptions m_Options {};
         tExecutionContextPtr m_ExecutionContext {};
+        TimerService::tTimerId m_TimerId { TimerService::InvalidTimerId };
+        _LatenessAccumulator m_Lateness {};
+        std::mutex mutable m_LatenessAccess;
         std::atomic<eAsyncState> m_State { eAsyncState::Free };
     };
 
     AsyncTimer::AsyncTimer(tDurationDelayRuntimeProvider const& durationDelayRuntimeProvider, tTask task
-                           , std::string name, tExceptionHandler exceptionHandler) noexcept(false)
+                           , std::string name, tExceptionHandler exceptionHandler
+                           , AsyncTimerOptions options) noexcept(false)
         : m_Impl(std::make_unique<_Impl>(durationDelayRuntimeProvider, std::move(task)
-                                         , std::move(name), std::move(exceptionHandler)))
+                                         , std::move(name), std::move(exceptionHandler), std::move(options)))
     {
         assert(durationDelayRuntimeProvider && "Bad data!");
         if (!durationDelayRuntimeProvider)
@@ -341,9 +498,21 @@ namespace Darkness::Concurrency {
         m_Impl->_Stop();
     }
 
+    TimerLatenessStatistics AsyncTimer::GetLatenessStatistics() const noexcept
+    {
+        return m_Impl->_GetLatenessStatistics();
+    }
+
+    void AsyncTimer::ResetLatenessStatistics() noexcept
+    {
+        m_Impl->_ResetLatenessStatistics();
+    }
+
     AsyncTimer::AsyncTimer(tDurationDelay const& durationDelay, tTask task
-                           , std::string name, tExceptionHandler exceptionHandler) noexcept(false)
-        : m_Impl(std::make_unique<_Impl>(durationDelay, std::move(task), std::move(name), std::move(exceptionHandler)))
+                           , std::string name, tExceptionHandler exceptionHandler
+                           , AsyncTimerOptions options) noexcept(false)
+        : m_Impl(std::make_unique<_Impl>(durationDelay, std::move(task), std::move(name), std::move(exceptionHandler)
+                                         , std::move(options)))
     {
     }
 } /// namespace Darkness::Concurrency
@@ -0,0 +1,283 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    CpuTopology.cpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Implementation of @class CpuTopology
+
+#include <Darkness/Concurrency/CpuTopology.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+namespace Darkness::Concurrency {
+    namespace {
+        [[nodiscard]] std::optional<std::string> ReadFirstLine(std::filesystem::path const& path)
+        {
+            std::ifstream file(path);
+            std::string line;
+            if (!file || !std::getline(file, line))
+            {
+                return std::nullopt;
+            }
+
+            return line;
+        }
+
+        [[nodiscard]] std::optional<std::size_t> ReadNumber(std::filesystem::path const& path)
+        {
+            auto const line = ReadFirstLine(path);
+            std::size_t number = 0;
+            if (!line || std::from_chars(line->data(), line->data() + line->size(), number).ec != std::errc {})
+            {
+                return std::nullopt;
+            }
+
+            return number;
+        }
+
+        /// @brief Parses the kernel CPU list format, for example "0-3,8,10-11".
+        [[nodiscard]] tCpuSet ParseCpuList(std::string_view text)
+        {
+            tCpuSet cpus;
+            while (!text.empty())
+            {
+                std::size_t first = 0;
+                auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), first);
+                if (error != std::errc {})
+                {
+                    break;
+                }
+
+                std::size_t last = first;
+                if (end != text.data() + text.size() && *end == '-')
+                {
+                    auto const [rangeEnd, rangeError] = std::from_chars(end + 1, text.data() + text.size(), last);
+                    if (rangeError != std::errc {} || last < first)
+                    {
+                        break;
+                    }
+
+                    end = rangeEnd;
+                }
+
+                for (std::size_t cpu = first; cpu <= last; ++cpu)
+                {
+                    cpus.push_back(cpu);
+                }
+
+                text.remove_prefix(std::size_t(end - text.data()));
+                if (text.empty() || text.front() != ',')
+                {
+                    break;
+                }
+
+                text.remove_prefix(1);
+            }
+
+            return cpus;
+        }
+
+        /// @brief Returns the CPUs which share the cache of the highest level with the CPU.
+        [[nodiscard]] std::optional<std::string> ReadLastLevelCacheKey(std::filesystem::path const& cpuPath)
+        {
+            std::optional<std::string> key;
+            std::size_t keyLevel = 0;
+            std::error_code errorCode;
+            for (auto const& entry : std::filesystem::directory_iterator(cpuPath / "cache", errorCode))
+            {
+                auto const& cachePath = entry.path();
+                auto const level = ReadNumber(cachePath / "level");
+                if (cachePath.filename().string().rfind("index", 0) != 0 || !level)
+                {
+                    continue;
+                }
+
+                if (*level >= keyLevel)
+                {
+                    if (auto sharedCpus = ReadFirstLine(cachePath / "shared_cpu_list"))
+                    {
+                        key = std::move(sharedCpus);
+                        keyLevel = *level;
+                    }
+                }
+            }
+
+            return key;
+        }
+
+        /// @brief Gives the groups indexes in order of their first appearance.
+        template<typename KeyT>
+        class Grouping final
+        {
+        public:
+            std::size_t Add(KeyT const& key, std::size_t cpu, std::vector<tCpuSet>& groups)
+            {
+                auto const [found, isInserted] = m_Indexes.emplace(key, groups.size());
+                if (isInserted)
+                {
+                    groups.emplace_back();
+                }
+
+                groups[found->second].push_back(cpu);
+                return found->second;
+            }
+
+        private:
+            std::map<KeyT, std::size_t> m_Indexes;
+        };
+    } /// end unnamed namespace
+
+    CpuTopology const& CpuTopology::Instance()
+    {
+        static CpuTopology const instance = Read();
+        return instance;
+    }
+
+    CpuTopology CpuTopology::Read(std::string const& root)
+    {
+        std::filesystem::path const cpuRoot = std::filesystem::path(root) / "cpu";
+        std::filesystem::path const nodeRoot = std::filesystem::path(root) / "node";
+
+        tCpuSet online;
+        if (auto const text = ReadFirstLine(cpuRoot / "online"))
+        {
+            online = ParseCpuList(*text);
+        }
+
+        if (online.empty())
+        {
+            online.resize(std::max<std::size_t>(std::thread::hardware_concurrency(), 1));
+            for (std::size_t cpu = 0; cpu < online.size(); ++cpu)
+            {
+                online[cpu] = cpu;
+            }
+        }
+
+        std::map<std::size_t, std::size_t> nodeOfCpu;
+        std::error_code errorCode;
+        for (auto const& entry : std::filesystem::directory_iterator(nodeRoot, errorCode))
+        {
+            std::string const name = entry.path().filename().string();
+            std::size_t node = 0;
+            if (name.rfind("node", 0) != 0
+                || std::from_chars(name.data() + 4, name.data() + name.size(), node).ec != std::errc {})
+            {
+                continue;
+            }
+
+            if (auto const text = ReadFirstLine(entry.path() / "cpulist"))
+            {
+                for (std::size_t const cpu : ParseCpuList(*text))
+                {
+                    nodeOfCpu[cpu] = node;
+                }
+            }
+        }
+
+        CpuTopology topology;
+        Grouping<std::pair<std::size_t, std::size_t>> cores;
+        Grouping<std::string> caches;
+        Grouping<std::size_t> nodes;
+        for (std::size_t const cpu : online)
+        {
+            auto const cpuPath = cpuRoot / ("cpu" + std::to_string(cpu));
+            auto const topologyPath = cpuPath / "topology";
+
+            std::size_t const package = ReadNumber(topologyPath / "physical_package_id").value_or(0);
+
+            /// @short Without the core id every logical CPU is a separate core.
+            auto const core = ReadNumber(topologyPath / "core_id");
+            auto const coreKey = core ? std::make_pair(package, *core) : std::make_pair(std::size_t(-1), cpu);
+
+            auto const cacheKey = ReadLastLevelCacheKey(cpuPath).value_or(std::string());
+            auto const found = nodeOfCpu.find(cpu);
+
+            LogicalCpu& logicalCpu = topology.m_Cpus.emplace_back();
+            logicalCpu.id = cpu;
+            logicalCpu.physicalCore = cores.Add(coreKey, cpu, topology.m_PhysicalCores);
+            logicalCpu.lastLevelCache = caches.Add(cacheKey, cpu, topology.m_LastLevelCaches);
+            logicalCpu.numaNode = nodes.Add(found != nodeOfCpu.end() ? found->second : 0, cpu, topology.m_NumaNodes);
+        }
+
+        return topology;
+    }
+
+    tCpuSet const& CpuTopology::GetWorkerCpuSet(eWorkerPlacement placement, std::size_t workerIndex) const
+    {
+        static tCpuSet const empty {};
+
+        std::vector<tCpuSet> const& groups = _GetGroups(placement);
+        return groups.empty() ? empty : groups[workerIndex % groups.size()];
+    }
+
+    ThreadAttributes CpuTopology::PlaceWorker(ThreadAttributes attributes, eWorkerPlacement placement
+                                              , std::size_t workerIndex) const
+    {
+        std::vector<tCpuSet> const& groups = _GetGroups(placement);
+        if (groups.empty())
+        {
+            return attributes;
+        }
+
+        if (attributes.cpuSet.empty())
+        {
+            attributes.cpuSet = groups[workerIndex % groups.size()];
+            return attributes;
+        }
+
+        std::ranges::sort(attributes.cpuSet);
+
+        /// @short The workers are distributed over the parts of the groups which are allowed by the attributes,
+        ///        the groups outside of them are skipped.
+        std::vector<tCpuSet> parts;
+        for (tCpuSet const& group : groups)
+        {
+            tCpuSet part;
+            std::ranges::set_intersection(group, attributes.cpuSet, std::back_inserter(part));
+            if (!part.empty())
+            {
+                parts.push_back(std::move(part));
+            }
+        }
+
+        if (!parts.empty())
+        {
+            attributes.cpuSet = std::move(parts[workerIndex % parts.size()]);
+        }
+
+        return attributes;
+    }
+
+    std::vector<tCpuSet> const& CpuTopology::_GetGroups(eWorkerPlacement placement) const noexcept
+    {
+        static std::vector<tCpuSet> const none {};
+
+        switch (placement)
+        {
+            case eWorkerPlacement::None:
+                break;
+
+            case eWorkerPlacement::PerPhysicalCore:
+                return m_PhysicalCores;
+
+            case eWorkerPlacement::PerLastLevelCache:
+                return m_LastLevelCaches;
+
+            case eWorkerPlacement::PerNumaNode:
+                return m_NumaNodes;
+        }
+
+        return none;
+    }
+} /// end namespace Darkness::Concurrency
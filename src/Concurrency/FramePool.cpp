@@ -0,0 +1,215 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    FramePool.cpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Implementation of @class FramePool
+
+#include <Darkness/Concurrency/Coroutine/FramePool.hpp>
+#include <Darkness/Concurrency/Spinlock.hpp>
+
+#include <array>
+#include <cassert>
+#include <mutex>
+#include <vector>
+
+namespace Darkness::Concurrency::Coroutine {
+    namespace {
+        constexpr std::size_t const ClassesCount = FramePool::MaxPooledSize / FramePool::Granularity;
+
+        /// @short A thread keeps up to LocalLimit free blocks of a class, the surplus goes to the depot
+        ///        by batches of BatchSize blocks.
+        constexpr std::size_t const BatchSize = 32;
+        constexpr std::size_t const LocalLimit = 2 * BatchSize;
+
+        struct FreeBlock final
+        {
+            FreeBlock* next;
+        };
+
+        struct FreeList final
+        {
+            void Push(FreeBlock* block) noexcept
+            {
+                block->next = head;
+                head = block;
+                ++count;
+            }
+
+            [[nodiscard]] FreeBlock* Pop() noexcept
+            {
+                FreeBlock* const block = head;
+                head = block->next;
+                --count;
+                return block;
+            }
+
+            /// @brief Detaches up to maxCount blocks from the head as a separate list.
+            [[nodiscard]] FreeList Split(std::size_t maxCount) noexcept
+            {
+                FreeList batch;
+                while (head && batch.count < maxCount)
+                {
+                    batch.Push(Pop());
+                }
+
+                return batch;
+            }
+
+            FreeBlock* head { nullptr };
+            std::size_t count { 0 };
+        };
+
+        constexpr std::size_t ClassOf(std::size_t size) noexcept
+        {
+            return (size + FramePool::Granularity - 1) / FramePool::Granularity - 1;
+        }
+
+        constexpr std::size_t SizeOf(std::size_t sizeClass) noexcept
+        {
+            return (sizeClass + 1) * FramePool::Granularity;
+        }
+
+        /// @brief Shared batches of free blocks per size class.
+        /// @short Is never destroyed: frames may be freed by static and thread-local objects at the exit.
+        class Depot final
+        {
+            using tLock = std::lock_guard<Spinlock> const;
+
+        public:
+            static Depot& Instance()
+            {
+                static Depot* const instance = new Depot();
+                return *instance;
+            }
+
+            void Put(std::size_t sizeClass, FreeList&& batch)
+            {
+                tLock lock(m_Access[sizeClass]);
+                m_Batches[sizeClass].push_back(batch);
+            }
+
+            [[nodiscard]] bool TryTake(std::size_t sizeClass, FreeList& batch) noexcept
+            {
+                tLock lock(m_Access[sizeClass]);
+                if (m_Batches[sizeClass].empty())
+                {
+                    return false;
+                }
+
+                batch = m_Batches[sizeClass].back();
+                m_Batches[sizeClass].pop_back();
+                return true;
+            }
+
+        private:
+            std::array<std::vector<FreeList>, ClassesCount> m_Batches;
+            std::array<Spinlock, ClassesCount> m_Access;
+        };
+
+        /// @short Is set when the cache of the thread is destroyed, later frames of the thread bypass the pool.
+        constinit thread_local bool isLocalCacheDestroyed = false;
+
+        /// @short Returns the cached blocks to the depot on the thread exit.
+        struct LocalCache final
+        {
+            LocalCache()
+                : depot(Depot::Instance())
+            {
+            }
+
+            ~LocalCache()
+            {
+                isLocalCacheDestroyed = true;
+                for (std::size_t sizeClass = 0; sizeClass < ClassesCount; ++sizeClass)
+                {
+                    if (lists[sizeClass].head)
+                    {
+                        depot.Put(sizeClass, std::move(lists[sizeClass]));
+                    }
+                }
+            }
+
+            std::array<FreeList, ClassesCount> lists;
+            Depot& depot;
+        };
+
+        /// @return nullptr if the cache of the thread is already destroyed.
+        LocalCache* GetLocalCache()
+        {
+            if (isLocalCacheDestroyed)
+            {
+                return nullptr;
+            }
+
+            thread_local LocalCache cache;
+            return &cache;
+        }
+    } /// end unnamed namespace
+
+    void* FramePool::Allocate(std::size_t size)
+    {
+        if (size > MaxPooledSize)
+        {
+            return ::operator new(size);
+        }
+
+        std::size_t const sizeClass = ClassOf(size);
+        LocalCache* const cache = GetLocalCache();
+        if (!cache)
+        {
+            return ::operator new(SizeOf(sizeClass));
+        }
+
+        FreeList& list = cache->lists[sizeClass];
+        if (!list.head && !cache->depot.TryTake(sizeClass, list))
+        {
+            return ::operator new(SizeOf(sizeClass));
+        }
+
+        return list.Pop();
+    }
+
+    void FramePool::Deallocate(void* block, std::size_t size) noexcept
+    {
+        if (!block)
+        {
+            return;
+        }
+
+        if (size > MaxPooledSize)
+        {
+            ::operator delete(block, size);
+            return;
+        }
+
+        std::size_t const sizeClass = ClassOf(size);
+        LocalCache* const cache = GetLocalCache();
+        if (!cache)
+        {
+            ::operator delete(block, SizeOf(sizeClass));
+            return;
+        }
+
+        FreeList& list = cache->lists[sizeClass];
+        list.Push(::new (block) FreeBlock { nullptr });
+        if (list.count > LocalLimit)
+        {
+            FreeList batch = list.Split(BatchSize);
+            try
+            {
+                cache->depot.Put(sizeClass, std::move(batch));
+            }
+            catch (...)
+            {
+                /// @short The depot could not grow, the blocks stay in the local list.
+                while (batch.head)
+                {
+                    list.Push(batch.Pop());
+                }
+            }
+        }
+    }
+} /// end namespace Darkness::Concurrency::Coroutine
@@ -0,0 +1,174 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    McsLock.cpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Implementation of @class McsLock
+
+#include "Darkness/Concurrency/McsLock.hpp"
+#include "Darkness/Concurrency/Utilities.hpp"
+
+#include <cassert>
+#include <thread>
+#include <utility>
+
+namespace Darkness::Concurrency {
+    struct alignas(CacheLineSize) McsLock::Node final
+    {
+        enum eState : std::uint32_t
+        {
+            Granted = 0
+            , Waiting = 1
+            , Parked = 2
+            , Waking = 3 /// The predecessor is notifying the parked successor and still uses its node.
+        };
+
+        std::atomic<Node*> next { nullptr };
+        std::atomic<std::uint32_t> state { Waiting };
+        Node* nextFree { nullptr }; /// The link of the thread-local pool.
+    };
+
+    namespace {
+        /// @short A thread may hold several McsLocks at once, so it needs a node per held lock. The node is free
+        ///        again right after unlock, because the successor never touches the node of its predecessor.
+        class _NodePool final
+        {
+        public:
+            ~_NodePool()
+            {
+                while (m_Free)
+                {
+                    delete std::exchange(m_Free, m_Free->nextFree);
+                }
+            }
+
+            McsLock::Node* _Acquire()
+            {
+                if (!m_Free)
+                {
+                    return new McsLock::Node();
+                }
+
+                McsLock::Node* const node = std::exchange(m_Free, m_Free->nextFree);
+                node->next.store(nullptr, std::memory_order_relaxed);
+                node->state.store(McsLock::Node::Waiting, std::memory_order_relaxed);
+                return node;
+            }
+
+            void _Release(McsLock::Node* node) noexcept
+            {
+                node->nextFree = std::exchange(m_Free, node);
+            }
+
+        private:
+            McsLock::Node* m_Free { nullptr };
+        };
+
+        thread_local _NodePool t_NodePool;
+    } /// end unnamed namespace
+
+    McsLock::McsLock() noexcept = default;
+
+    void McsLock::lock() noexcept
+    {
+        Node* const node = t_NodePool._Acquire();
+
+        Node* const predecessor = m_Tail.exchange(node, std::memory_order_acq_rel);
+        if (predecessor)
+        {
+            predecessor->next.store(node, std::memory_order_release);
+
+            std::uint32_t round = 0;
+            for (; round < _SpinRounds && node->state.load(std::memory_order_acquire) != Node::Granted; ++round)
+            {
+                CpuRelax();
+            }
+
+            if (round == _SpinRounds)
+            {
+                std::uint32_t expected = Node::Waiting;
+                if (node->state.compare_exchange_strong(expected, Node::Parked, std::memory_order_acquire))
+                {
+                    node->state.wait(Node::Parked, std::memory_order_acquire);
+                }
+
+                /// @short The node goes back to the pool only after the predecessor has finished the notification.
+                for (round = 0; node->state.load(std::memory_order_acquire) != Node::Granted; ++round)
+                {
+                    if (round < _SpinRounds)
+                    {
+                        CpuRelax();
+                    }
+                    else
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+        }
+
+        m_Owner = node;
+    }
+
+    bool McsLock::try_lock() noexcept
+    {
+        Node* const node = t_NodePool._Acquire();
+
+        Node* expected = nullptr;
+        if (!m_Tail.compare_exchange_strong(expected, node, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            t_NodePool._Release(node);
+            return false;
+        }
+
+        m_Owner = node;
+        return true;
+    }
+
+    void McsLock::unlock() noexcept
+    {
+        Node* const node = std::exchange(m_Owner, nullptr);
+        assert(node && "Bad logic! The lock is not owned!");
+
+        Node* successor = node->next.load(std::memory_order_acquire);
+        if (!successor)
+        {
+            Node* expected = node;
+            if (m_Tail.compare_exchange_strong(expected, nullptr, std::memory_order_release
+                                               , std::memory_order_relaxed))
+            {
+                t_NodePool._Release(node);
+                return;
+            }
+
+            /// @short The successor has already taken the tail but has not linked itself yet.
+            for (std::uint32_t round = 0; !(successor = node->next.load(std::memory_order_acquire)); ++round)
+            {
+                if (round < _SpinRounds)
+                {
+                    CpuRelax();
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        std::uint32_t expected = Node::Waiting;
+        if (!successor->state.compare_exchange_strong(expected, Node::Granted, std::memory_order_release
+                                                      , std::memory_order_relaxed))
+        {
+            assert(expected == Node::Parked && "Bad logic! The successor is neither waiting nor parked!");
+
+            /// @short Granted is stored last: once the successor sees it, it may free the node with its thread.
+            successor->state.store(Node::Waking, std::memory_order_relaxed);
+            successor->state.notify_one();
+            successor->state.store(Node::Granted, std::memory_order_release);
+        }
+
+        t_NodePool._Release(node);
+    }
+} /// namespace Darkness::Concurrency
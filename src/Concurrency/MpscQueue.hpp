@@ -0,0 +1,262 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    MpscQueue.hpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Implementation of @class MpscQueue. Lock-free multi-producer/single-consumer queue which is based on
+///          a bounded ring with an unbounded (mutex protected) overflow path.
+///          @short Producers reserve a ring cell by CAS on the head position and publish the value by the cell flag.
+///                 The consumer owns the tail position and publishes it back to the producers. When the ring is full
+///                 the values go to the overflow deque, and all next values go there too until the consumer takes
+///                 it entirely, so the order of values from one producer is always kept.
+
+#pragma once
+
+#include <Darkness/Concurrency/Types.hpp>
+
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace Darkness::Concurrency {
+    template<typename T>
+    class MpscQueue final
+    {
+        struct _Cell final
+        {
+            std::atomic<bool> ready { false };
+            alignas(T) std::byte storage[sizeof(T)];
+        };
+
+        using tPosition = std::uint64_t;
+        using tCells = std::unique_ptr<_Cell[]>;
+        using tOverflow = std::deque<T>;
+        using tOverflowLock = std::lock_guard<std::mutex> const;
+
+    public:
+        using value_type = T;
+
+    public:
+        /// @param capacity The ring capacity. Will be rounded up to a power of two.
+        explicit MpscQueue(std::size_t capacity = DefaultCapacity)
+            : m_Capacity(std::bit_ceil(capacity < 2 ? std::size_t(2) : capacity))
+              , m_Mask(m_Capacity - 1)
+              , m_Cells(std::make_unique<_Cell[]>(m_Capacity))
+        {
+        }
+
+        ~MpscQueue()
+        {
+            Clear();
+        }
+
+        MpscQueue(MpscQueue const&) = delete;
+
+        MpscQueue(MpscQueue&&) = delete;
+
+        MpscQueue& operator=(MpscQueue const&) = delete;
+
+        MpscQueue& operator=(MpscQueue&&) = delete;
+
+        /// @brief Pushes the value. Can be called from any thread.
+        void Push(T&& value)
+        {
+            if (m_OverflowSize.load(std::memory_order_acquire) == 0 && _TryPushToRing(std::span<T>(&value, 1)))
+            {
+                return;
+            }
+
+            tOverflowLock lock(m_OverflowAccess);
+            m_Overflow.push_back(std::move(value));
+            m_OverflowSize.fetch_add(1, std::memory_order_release);
+        }
+
+        /// @brief Pushes all values at once. Can be called from any thread.
+        /// @short The ring cells for all values are reserved by one CAS. If the ring has no room for all of them
+        ///        then all of them go to the overflow by one lock acquisition. The values are moved from.
+        void PushBatch(std::span<T> values)
+        {
+            if (values.empty())
+            {
+                return;
+            }
+
+            if (m_OverflowSize.load(std::memory_order_acquire) == 0 && _TryPushToRing(values))
+            {
+                return;
+            }
+
+            tOverflowLock lock(m_OverflowAccess);
+            for (auto& value : values)
+            {
+                m_Overflow.push_back(std::move(value));
+            }
+
+            m_OverflowSize.fetch_add(values.size(), std::memory_order_release);
+        }
+
+        /// @brief Pops a value. Consumer side only.
+        /// @return false if nothing is available right now.
+        [[nodiscard]] bool TryPop(T& value)
+        {
+            if (!m_Spilled.empty())
+            {
+                value = std::move(m_Spilled.front());
+                m_Spilled.pop_front();
+                return true;
+            }
+
+            _Cell& cell = m_Cells[m_TailLocal & m_Mask];
+            if (cell.ready.load(std::memory_order_acquire))
+            {
+                value = _Take(cell);
+                m_Tail.store(++m_TailLocal, std::memory_order_release);
+                return true;
+            }
+
+            return _TrySpillOverflow() && TryPop(value);
+        }
+
+        /// @brief Pops up to maxCount available values at once. Consumer side only.
+        /// @short The tail position is published to the producers once per batch.
+        /// @return The number of values which were appended to values.
+        std::size_t PopBatch(std::vector<T>& values, std::size_t maxCount)
+        {
+            std::size_t count = 0;
+            for (; count < maxCount && !m_Spilled.empty(); ++count)
+            {
+                values.push_back(std::move(m_Spilled.front()));
+                m_Spilled.pop_front();
+            }
+
+            tPosition position = m_TailLocal;
+            for (; count < maxCount; ++count, ++position)
+            {
+                _Cell& cell = m_Cells[position & m_Mask];
+                if (!cell.ready.load(std::memory_order_acquire))
+                {
+                    break;
+                }
+
+                values.push_back(_Take(cell));
+            }
+
+            if (position != m_TailLocal)
+            {
+                m_TailLocal = position;
+                m_Tail.store(position, std::memory_order_release);
+            }
+
+            if (count < maxCount && _TrySpillOverflow())
+            {
+                count += PopBatch(values, maxCount - count);
+            }
+
+            return count;
+        }
+
+        /// @brief Checks for emptiness. Consumer side only.
+        /// @short A reserved but not yet published cell is reported as non-empty.
+        [[nodiscard]] bool IsEmpty() const noexcept
+        {
+            return m_Spilled.empty()
+                   && m_Head.load(std::memory_order_acquire) == m_TailLocal
+                   && m_OverflowSize.load(std::memory_order_acquire) == 0;
+        }
+
+        /// @brief Destroys all available values. Consumer side only.
+        /// @return The number of destroyed values.
+        std::size_t Clear()
+        {
+            std::size_t count = 0;
+            T value;
+            while (TryPop(value))
+            {
+                value = {};
+                ++count;
+            }
+
+            return count;
+        }
+
+    private:
+        /// @short The overflow is taken only when the ring is really drained, otherwise older ring values of the
+        ///        same producer could be executed after its newer overflow values. The whole overflow is taken
+        ///        by one lock acquisition and is served before the ring.
+        bool _TrySpillOverflow()
+        {
+            if (m_OverflowSize.load(std::memory_order_acquire) == 0
+                || m_Head.load(std::memory_order_acquire) != m_TailLocal)
+            {
+                return false;
+            }
+
+            tOverflowLock lock(m_OverflowAccess);
+            m_Spilled.swap(m_Overflow);
+            m_OverflowSize.store(0, std::memory_order_release);
+            return !m_Spilled.empty();
+        }
+
+        bool _TryPushToRing(std::span<T> values)
+        {
+            std::size_t const count = values.size();
+            tPosition position = m_Head.load(std::memory_order_relaxed);
+            do
+            {
+                /// @short The position may be stale and already passed by the consumer, so the distance is signed.
+                tPosition const tail = m_Tail.load(std::memory_order_acquire);
+                if (static_cast<std::int64_t>(position + count - tail) > static_cast<std::int64_t>(m_Capacity))
+                {
+                    return false;
+                }
+            }
+            while (!m_Head.compare_exchange_weak(position, position + count
+                                                 , std::memory_order_relaxed, std::memory_order_relaxed));
+
+            for (auto& value : values)
+            {
+                _Cell& cell = m_Cells[position++ & m_Mask];
+                assert(!cell.ready.load(std::memory_order_relaxed) && "Bad logic!");
+                ::new (static_cast<void*>(cell.storage)) T(std::move(value));
+                cell.ready.store(true, std::memory_order_release);
+            }
+
+            return true;
+        }
+
+        static T _Take(_Cell& cell)
+        {
+            T* const stored = std::launder(reinterpret_cast<T*>(cell.storage));
+            T value = std::move(*stored);
+            stored->~T();
+            cell.ready.store(false, std::memory_order_relaxed);
+            return value;
+        }
+
+    public:
+        static constexpr std::size_t const DefaultCapacity = 1024;
+
+    private:
+        std::size_t const m_Capacity;
+        std::size_t const m_Mask;
+        tCells const m_Cells;
+        alignas(CacheLineSize) std::atomic<tPosition> m_Head { 0 };
+        alignas(CacheLineSize) std::atomic<tPosition> m_Tail { 0 };
+        tPosition m_TailLocal { 0 };
+        alignas(CacheLineSize) std::atomic<std::size_t> m_OverflowSize { 0 };
+        std::mutex m_OverflowAccess;
+        tOverflow m_Overflow;
+        tOverflow m_Spilled;
+    };
+} /// end namespace Darkness::Concurrency
@@ -12,10 +12,14 @@
 #include <Darkness/Common/Utilities.hpp>
 #include <Darkness/Concurrency/Utilities.hpp>
 #include <Darkness/Concurrency/QueueManager.hpp>
+#include <Darkness/Concurrency/CpuTopology.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <iomanip>
+#include <iterator>
+#include <string>
 
 namespace Darkness::Concurrency {
 
@@ -45,6 +49,7 @@ namespace Darkness::Concurrency {
         if (queue)
         {
             m_Worker = std::jthread([queue](std::stop_token stopToken) {
+                queue->_ApplyThreadAttributes(queue->m_Options.threadAttributes);
                 queue->_Routine(std::move(stopToken));
             });
         }
@@ -60,20 +65,269 @@ namespace Darkness::Concurrency {
         return m_Worker.get_stop_token();
     }
 
+    namespace {
+        struct _CurrentPoolWorker final
+        {
+            Queue::ThreadPoolExecutionPolicy const* policy { nullptr };
+            std::size_t index { 0 };
+        };
+
+        thread_local _CurrentPoolWorker t_CurrentPoolWorker {};
+    } /// end unnamed namespace
+
+    Queue::ThreadPoolExecutionPolicy::ThreadPoolExecutionPolicy(std::size_t workersCount)
+    {
+        if (workersCount == 0)
+        {
+            workersCount = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+        }
+
+        m_Workers.resize(workersCount);
+        for (auto& worker : m_Workers)
+        {
+            worker = std::make_unique<_Worker>();
+        }
+    }
+
+    Queue::ThreadPoolExecutionPolicy::~ThreadPoolExecutionPolicy()
+    {
+        m_StopSource.request_stop();
+        m_Threads.clear();
+    }
+
+    void Queue::ThreadPoolExecutionPolicy::Start(Queue* queue)
+    {
+        assert(queue && "Bad data!");
+        if (queue)
+        {
+            m_Threads.clear(); /// Joins the workers of the previous start.
+
+            m_StopSource = {};
+            m_RunningCount = m_Workers.size();
+            queue->m_State = eAsyncState::Busy;
+
+            for (std::size_t index = 0; index < m_Workers.size(); ++index)
+            {
+                m_Threads.emplace_back([this, queue, index] {
+                    _Routine(queue, index);
+                });
+            }
+        }
+    }
+
+    bool Queue::ThreadPoolExecutionPolicy::RequestStop()
+    {
+        return m_StopSource.request_stop();
+    }
+
+    std::stop_token Queue::ThreadPoolExecutionPolicy::GetStopToken() const noexcept
+    {
+        return m_StopSource.get_token();
+    }
+
+    bool Queue::ThreadPoolExecutionPolicy::TryPostFromWorker(tQueuedTask& task)
+    {
+        if (t_CurrentPoolWorker.policy != this)
+        {
+            return false;
+        }
+
+        _PushLocal(*m_Workers[t_CurrentPoolWorker.index], std::move(task));
+        return true;
+    }
+
+    void Queue::ThreadPoolExecutionPolicy::_Routine(Queue* queue, std::size_t index) noexcept
+    {
+        t_CurrentPoolWorker = { this, index };
+        if (index == 0)
+        {
+            queue->m_Id = std::this_thread::get_id();
+        }
+
+        Common::ScopeExit const scopeExit { [this, queue] {
+            t_CurrentPoolWorker = {};
+            if (m_RunningCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                /// @short The last worker drops pending tasks, nobody else consumes them now.
+                for (auto& worker : m_Workers)
+                {
+                    tWorkerLock lock(worker->access);
+                    queue->_OnDropped(worker->tasks.size());
+                    worker->tasks.clear();
+                    worker->size = 0;
+                }
+
+                std::lock_guard const lock(m_SharedAccess);
+                queue->_OnDropped(queue->m_TaskQueue.Clear());
+                queue->m_Id.store({});
+                queue->m_State = eAsyncState::Stopped;
+            }
+        }};
+
+        SetCurrentThreadName(queue->m_Name + '#' + std::to_string(index));
+        if (queue->m_Options.workerPlacement != eWorkerPlacement::None)
+        {
+            queue->_ApplyThreadAttributes(CpuTopology::Instance().PlaceWorker(queue->m_Options.threadAttributes
+                                                                              , queue->m_Options.workerPlacement
+                                                                              , index));
+        }
+        else
+        {
+            queue->_ApplyThreadAttributes(queue->m_Options.threadAttributes);
+        }
+
+        auto const stopToken = m_StopSource.get_token();
+        std::exception_ptr exceptionPtr {};
+
+        try
+        {
+            tQueuedTask task;
+            while (!stopToken.stop_requested())
+            {
+                if (_TryPopLocal(index, task) || _TryPopShared(queue, index, task) || _TrySteal(index, task))
+                {
+                    queue->_Execute(task);
+                    task = nullptr;
+                    continue;
+                }
+
+                queue->_Park(stopToken, [this, queue] {
+                    return !_HasWork(queue);
+                });
+            }
+        }
+        catch (...)
+        {
+            exceptionPtr = std::current_exception();
+
+            if (queue->m_ExceptionHandler)
+            {
+                queue->m_ExceptionHandler(exceptionPtr);
+            }
+        }
+    }
+
+    bool Queue::ThreadPoolExecutionPolicy::_TryPopLocal(std::size_t index, tQueuedTask& task)
+    {
+        _Worker& worker = *m_Workers[index];
+        if (worker.size.load(std::memory_order_relaxed) == 0)
+        {
+            return false;
+        }
+
+        tWorkerLock lock(worker.access);
+        if (worker.tasks.empty())
+        {
+            return false;
+        }
+
+        /// @short The owner takes the most recent task, it is most likely hot in the cache.
+        task = std::move(worker.tasks.back());
+        worker.tasks.pop_back();
+        worker.size.store(worker.tasks.size(), std::memory_order_relaxed);
+        return true;
+    }
+
+    bool Queue::ThreadPoolExecutionPolicy::_TryPopShared(Queue* queue, std::size_t index, tQueuedTask& task)
+    {
+        _Worker& worker = *m_Workers[index];
+        {
+            std::unique_lock const lock(m_SharedAccess, std::try_to_lock);
+            if (!lock || queue->m_TaskQueue.PopBatch(worker.batch, queue->m_Options.maxBatchSize) == 0)
+            {
+                return false;
+            }
+        }
+
+        task = std::move(worker.batch.front());
+        if (worker.batch.size() > 1)
+        {
+            {
+                tWorkerLock lock(worker.access);
+                std::move(std::next(worker.batch.begin()), worker.batch.end(), std::back_inserter(worker.tasks));
+                worker.size.store(worker.tasks.size(), std::memory_order_relaxed);
+            }
+
+            /// @short The rest of the batch is available for stealing by parked siblings.
+            queue->_Notify();
+        }
+
+        worker.batch.clear();
+        return true;
+    }
+
+    bool Queue::ThreadPoolExecutionPolicy::_TrySteal(std::size_t index, tQueuedTask& task)
+    {
+        for (std::size_t offset = 1; offset < m_Workers.size(); ++offset)
+        {
+            _Worker& victim = *m_Workers[(index + offset) % m_Workers.size()];
+            if (victim.size.load(std::memory_order_relaxed) == 0)
+            {
+                continue;
+            }
+
+            tWorkerLock lock(victim.access);
+            if (!victim.tasks.empty())
+            {
+                /// @short The thief takes the oldest task.
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                victim.size.store(victim.tasks.size(), std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool Queue::ThreadPoolExecutionPolicy::_HasWork(Queue* queue)
+    {
+        for (auto const& worker : m_Workers)
+        {
+            if (worker->size.load(std::memory_order_relaxed) != 0)
+            {
+                return true;
+            }
+        }
+
+        std::unique_lock const lock(m_SharedAccess, std::try_to_lock);
+        return !lock || !queue->m_TaskQueue.IsEmpty(); /// A sibling is taking tasks right now.
+    }
+
+    void Queue::ThreadPoolExecutionPolicy::_PushLocal(_Worker& worker, tQueuedTask&& task)
+    {
+        tWorkerLock lock(worker.access);
+        worker.tasks.push_back(std::move(task));
+        worker.size.store(worker.tasks.size(), std::memory_order_relaxed);
+    }
+
     Queue::Queue(std::string name, tExceptionHandler exceptionHandler
-                 , tExecutionPolicyPtr executionPolicy) noexcept
+                 , tExecutionPolicyPtr executionPolicy, QueueOptions const& options) noexcept
         : m_Name(std::move(name))
           , m_ExceptionHandler(std::move(exceptionHandler))
+          , m_Options(options)
           , m_ExecutionPolicy(std::move(executionPolicy))
           , m_State(eAsyncState::Free)
+          , m_Sleepers(0)
+          , m_WakeSignal(0)
+#if defined(Darkness_Concurrency_TRACE)
+          , m_TraceNameId(Tracer::Instance().Intern(m_Name))
+#endif /// Darkness_Concurrency_TRACE
     {
         assert(!m_Name.empty() && "Bad data!");
         assert(m_ExecutionPolicy && "Bad data!");
+        assert(m_Options.maxBatchSize != 0 && "Bad data!");
     }
 
     Queue::~Queue()
     {
         _Stop();
+
+        /// @short The worker could be not started yet, then _Stop has no effect. So the stop is requested and
+        ///        the worker is woken up unconditionally, it should be joined before destruction of the task queue.
+        m_ExecutionPolicy->RequestStop();
+        _NotifyAll();
+        m_ExecutionPolicy.reset();
     }
 
     void Queue::Start()
@@ -113,18 +367,39 @@ namespace Darkness::Concurrency {
         return m_State;
     }
 
-    void Queue::Post(tTask&& task)
+    void Queue::Post(tTask&& task, [[maybe_unused]] tPostLocation location)
     {
-        tUniquLock const lock(m_Mutex);
-        m_TaskQueue.push_back(std::forward<tTask>(task));
-        m_Condition.notify_one();
+        _OnEnqueued(1);
+
+        /// @short Without metrics and tracing it is a reference to the task itself.
+        tQueuedTask&& queued = _Wrap(std::move(task), location);
+        if (!m_ExecutionPolicy->TryPostFromWorker(queued))
+        {
+            m_TaskQueue.Push(std::move(queued));
+        }
+
+        _Notify();
     }
 
-    void Queue::Post(tTask const& task)
+    void Queue::PostBatch(std::span<tTask> tasks, [[maybe_unused]] tPostLocation location)
     {
-        tUniquLock const lock(m_Mutex);
-        m_TaskQueue.push_back(task);
-        m_Condition.notify_one();
+        if (!tasks.empty())
+        {
+            _OnEnqueued(tasks.size());
+#if defined(Darkness_Concurrency_Queue_WRAPPED_TASKS)
+            std::vector<tQueuedTask> queued;
+            queued.reserve(tasks.size());
+            for (auto& task : tasks)
+            {
+                queued.push_back(_Wrap(std::move(task), location));
+            }
+
+            m_TaskQueue.PushBatch(queued);
+#else
+            m_TaskQueue.PushBatch(tasks);
+#endif /// Darkness_Concurrency_Queue_WRAPPED_TASKS
+            _Notify();
+        }
     }
 
     std::thread::id Queue::GetWorkThreadId() const noexcept
@@ -137,6 +412,26 @@ namespace Darkness::Concurrency {
         return m_Name;
     }
 
+    QueueMetrics Queue::GetMetrics() const noexcept
+    {
+        QueueMetrics metrics;
+#if defined(Darkness_Concurrency_Queue_METRICS)
+        metrics.isEnabled = true;
+
+        /// @short Enqueued is read last and is incremented before the tasks are published, so the depth is not
+        ///        negative.
+        metrics.executedCount = m_Metrics.executed.load(std::memory_order_relaxed);
+        metrics.droppedCount = m_Metrics.dropped.load(std::memory_order_relaxed);
+        metrics.enqueuedCount = m_Metrics.enqueued.load(std::memory_order_acquire);
+        metrics.depth = metrics.enqueuedCount - std::min(metrics.enqueuedCount
+                                                         , metrics.executedCount + metrics.droppedCount);
+        metrics.peakDepth = std::max(m_Metrics.peakDepth.load(std::memory_order_relaxed), metrics.depth);
+        m_Metrics.waitTime.CopyTo(metrics.waitTime);
+        m_Metrics.serviceTime.CopyTo(metrics.serviceTime);
+#endif /// Darkness_Concurrency_Queue_METRICS
+        return metrics;
+    }
+
     void Queue::_Stop()
     {
         switch (m_State)
@@ -170,8 +465,6 @@ namespace Darkness::Concurrency {
 
     void Queue::_DoStop()
     {
-        tUniquLock const lock(m_Mutex);
-
 #if defined(Darkness_Concurrency_Queue_DEBUG)
         /// @short Other way to check for a call itself from this thread.
         auto const callerThreadId = std::this_thread::get_id();
@@ -184,7 +477,7 @@ namespace Darkness::Concurrency {
 
         m_State = eAsyncState::Stopping;
 
-        m_TaskQueue.clear();
+        /// @short Pending tasks are dropped by the worker itself, because it is the only consumer of the task queue.
 
         bool const stopPossible = m_ExecutionPolicy->GetStopToken().stop_possible();
         assert(stopPossible && "Bad logic!");
@@ -192,7 +485,7 @@ namespace Darkness::Concurrency {
         bool const stopRequested = m_ExecutionPolicy->RequestStop();
         assert(stopRequested && "Bad logic!");
 
-        m_Condition.notify_all();
+        _NotifyAll();
     }
 
     void Queue::_Routine(std::stop_token stopToken) noexcept
@@ -216,46 +509,30 @@ namespace Darkness::Concurrency {
 
         std::exception_ptr exceptionPtr {};
 
+        std::size_t const maxBatchSize = std::max<std::size_t>(m_Options.maxBatchSize, 1);
+        tTaskBatch batch;
+        batch.reserve(maxBatchSize);
+
         try
         {
             while (!stopToken.stop_requested())
             {
-                tTask task;
+                if (m_TaskQueue.PopBatch(batch, maxBatchSize) == 0)
                 {
-                    tUniquLock lock(m_Mutex);
-                    m_Condition.wait(lock, [this, &task, &stopToken] {
-                        if (stopToken.stop_requested())
-                        {
-                            return true;
-                        }
-
-                        if (!m_TaskQueue.empty())
-                        {
-                            task = std::move(m_TaskQueue.front());
-                            m_TaskQueue.pop_front();
-                            return true;
-                        }
-
-                        return false; /// Continue waiting...
+                    _Park(stopToken, [this] {
+                        return m_TaskQueue.IsEmpty();
                     });
+                    continue;
                 }
 
-                if (task)
+                std::size_t executed = 0;
+                for (; executed < batch.size() && !stopToken.stop_requested(); ++executed)
                 {
-                    try
-                    {
-                        task();
-                    }
-                    catch (...)
-                    {
-                        exceptionPtr = std::current_exception();
-
-                        if (m_ExceptionHandler)
-                        {
-                            m_ExceptionHandler(exceptionPtr);
-                        }
-                    }
+                    _Execute(batch[executed]);
                 }
+
+                _OnDropped(batch.size() - executed);
+                batch.clear();
             }
         }
         catch (...)
@@ -267,6 +544,177 @@ namespace Darkness::Concurrency {
                 m_ExceptionHandler(exceptionPtr);
             }
         }
+
+        batch.clear();
+        _OnDropped(m_TaskQueue.Clear());
+    }
+
+    void Queue::_ApplyThreadAttributes(ThreadAttributes const& attributes) const noexcept
+    {
+        if (!attributes.IsEmpty() && !SetCurrentThreadAttributes(attributes))
+        {
+#if defined(Darkness_Concurrency_Queue_DEBUG)
+            std::cerr << "Queue: some thread attributes of the queue " << std::quoted(m_Name)
+                      << " are not applied!" << '\n';
+#endif /// Darkness_Concurrency_Queue_DEBUG
+        }
+    }
+
+    void Queue::_Execute(tTask& task)
+    {
+        if (task)
+        {
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                if (m_ExceptionHandler)
+                {
+                    m_ExceptionHandler(std::current_exception());
+                }
+            }
+        }
+    }
+
+#if defined(Darkness_Concurrency_Queue_WRAPPED_TASKS)
+    Queue::_QueuedTask Queue::_Wrap(tTask&& task, [[maybe_unused]] tPostLocation const& location) noexcept
+    {
+        _QueuedTask queued(std::move(task));
+        queued.location = location;
+#if defined(Darkness_Concurrency_Queue_METRICS)
+        queued.postedAt = tMetricsClock::now();
+#endif /// Darkness_Concurrency_Queue_METRICS
+#if defined(Darkness_Concurrency_TRACE)
+        queued.flowId = Tracer::Instance().RecordPost(m_TraceNameId, eTraceCategory::Queue);
+#endif /// Darkness_Concurrency_TRACE
+        return queued;
+    }
+
+    void Queue::_Execute(_QueuedTask& task)
+    {
+#if defined(Darkness_Concurrency_TRACE)
+        TraceScope const traceScope(m_TraceNameId, eTraceCategory::Queue, task.flowId);
+#endif /// Darkness_Concurrency_TRACE
+#if defined(Darkness_Concurrency_TASK_PROFILER)
+        TaskProfileScope const profileScope(task.location);
+#endif /// Darkness_Concurrency_TASK_PROFILER
+#if defined(Darkness_Concurrency_Queue_METRICS)
+        auto const startedAt = tMetricsClock::now();
+        m_Metrics.waitTime.Add(startedAt - task.postedAt);
+#endif /// Darkness_Concurrency_Queue_METRICS
+
+        _Execute(task.task);
+
+#if defined(Darkness_Concurrency_Queue_METRICS)
+        m_Metrics.serviceTime.Add(tMetricsClock::now() - startedAt);
+        m_Metrics.executed.fetch_add(1, std::memory_order_relaxed);
+#endif /// Darkness_Concurrency_Queue_METRICS
+    }
+#endif /// Darkness_Concurrency_Queue_WRAPPED_TASKS
+
+#if defined(Darkness_Concurrency_Queue_METRICS)
+    void Queue::_AtomicHistogram::Add(std::chrono::nanoseconds duration) noexcept
+    {
+        auto const nanoseconds = static_cast<std::uint64_t>(std::max<std::int64_t>(duration.count(), 0));
+        buckets[LatencyHistogram::GetBucketIndex(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+        total.fetch_add(nanoseconds, std::memory_order_relaxed);
+    }
+
+    void Queue::_AtomicHistogram::CopyTo(LatencyHistogram& histogram) const noexcept
+    {
+        histogram.count = 0;
+        for (std::size_t index = 0; index < LatencyHistogram::BucketsCount; ++index)
+        {
+            histogram.buckets[index] = buckets[index].load(std::memory_order_relaxed);
+            histogram.count += histogram.buckets[index];
+        }
+
+        histogram.total = std::chrono::nanoseconds(total.load(std::memory_order_relaxed));
     }
+#endif /// Darkness_Concurrency_Queue_METRICS
 
+    void Queue::_OnEnqueued([[maybe_unused]] std::size_t count) noexcept
+    {
+#if defined(Darkness_Concurrency_Queue_METRICS)
+        std::uint64_t const enqueued = m_Metrics.enqueued.fetch_add(count, std::memory_order_release) + count;
+        std::uint64_t const done = m_Metrics.executed.load(std::memory_order_relaxed)
+                                   + m_Metrics.dropped.load(std::memory_order_relaxed);
+        std::uint64_t const depth = enqueued - std::min(enqueued, done);
+
+        auto peakDepth = m_Metrics.peakDepth.load(std::memory_order_relaxed);
+        while (depth > peakDepth
+               && !m_Metrics.peakDepth.compare_exchange_weak(peakDepth, depth, std::memory_order_relaxed))
+        {
+        }
+#endif /// Darkness_Concurrency_Queue_METRICS
+    }
+
+    void Queue::_OnDropped([[maybe_unused]] std::size_t count) noexcept
+    {
+#if defined(Darkness_Concurrency_Queue_METRICS)
+        if (count != 0)
+        {
+            m_Metrics.dropped.fetch_add(count, std::memory_order_relaxed);
+        }
+#endif /// Darkness_Concurrency_Queue_METRICS
+    }
+
+    void Queue::_Notify() noexcept
+    {
+        /// @short Pairs with the fence into _Park: either the worker sees the new task or we see the sleeper.
+        ///        Only the producer which has claimed a sleeper pays for its wake-up.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto sleepers = m_Sleepers.load(std::memory_order_relaxed);
+        while ((sleepers & _SleepersMask) != 0)
+        {
+            if (m_Sleepers.compare_exchange_weak(sleepers, sleepers - 1 + _Claim, std::memory_order_acq_rel))
+            {
+                m_WakeSignal.fetch_add(1, std::memory_order_release);
+                m_WakeSignal.notify_one();
+                break;
+            }
+        }
+    }
+
+    void Queue::_NotifyAll() noexcept
+    {
+        m_WakeSignal.fetch_add(1, std::memory_order_release);
+        m_WakeSignal.notify_all();
+    }
+
+    template<typename IdlePredicateT>
+    void Queue::_Park(std::stop_token const& stopToken, IdlePredicateT&& isIdle) noexcept
+    {
+        tWakeSignal const wakeSignal = m_WakeSignal.load(std::memory_order_acquire);
+
+        m_Sleepers.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (isIdle() && !stopToken.stop_requested())
+        {
+            m_WakeSignal.wait(wakeSignal, std::memory_order_acquire);
+            _Unpark();
+            return;
+        }
+
+        _Unpark();
+
+        /// @short A producer has reserved a cell but has not published it yet.
+        std::this_thread::yield();
+    }
+
+    void Queue::_Unpark() noexcept
+    {
+        /// @short The worker takes a claim if a producer has made one. Otherwise it was woken up by _NotifyAll or
+        ///        together with a claimed worker, or did not sleep at all, and it is still one of the sleepers.
+        auto sleepers = m_Sleepers.load(std::memory_order_relaxed);
+        do
+        {
+            assert(sleepers != 0 && "Bad logic! The worker is not counted in the sleepers!");
+        }
+        while (!m_Sleepers.compare_exchange_weak(sleepers, sleepers >= _Claim ? sleepers - _Claim : sleepers - 1
+                                                  , std::memory_order_relaxed));
+    }
 } /// end namespace Darkness::Concurrency
@@ -10,18 +10,97 @@
 #pragma once
 
 #include <Darkness/Concurrency/IQueue.hpp>
+#include <Darkness/Concurrency/Spinlock.hpp>
+#include <Darkness/Concurrency/TaskProfiler.hpp>
+#include <Darkness/Concurrency/Tracer.hpp>
+#include "MpscQueue.hpp"
 
-#include <deque>
 #include <thread>
-#include <mutex>
-#include <condition_variable>
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+/// @short Tasks are wrapped with the data of their posting only when metrics, tracing or profiling are compiled in.
+#if defined(Darkness_Concurrency_Queue_METRICS) || defined(Darkness_Concurrency_TRACE) \
+    || defined(Darkness_Concurrency_TASK_PROFILER)
+#define Darkness_Concurrency_Queue_WRAPPED_TASKS
+#endif
 
 namespace Darkness::Concurrency {
     class Queue final : public IQueue
     {
-        using tTaskQueue = std::deque<tTask>;
-        using tUniquLock = std::unique_lock<std::mutex>;
+#if defined(Darkness_Concurrency_Queue_WRAPPED_TASKS)
+        using tMetricsClock = std::chrono::steady_clock;
+
+        /// @brief The task with the time of its posting for the wait time metric, the trace flow which links
+        ///        the posting with the execution and the place of the posting for the profiler.
+        struct _QueuedTask final
+        {
+            _QueuedTask() noexcept = default;
+
+            explicit _QueuedTask(tTask&& task) noexcept
+                : task(std::move(task))
+            {
+            }
+
+            _QueuedTask& operator=(std::nullptr_t) noexcept
+            {
+                task = nullptr;
+                return *this;
+            }
+
+            tTask task;
+#if defined(Darkness_Concurrency_Queue_METRICS)
+            tMetricsClock::time_point postedAt {};
+#endif /// Darkness_Concurrency_Queue_METRICS
+#if defined(Darkness_Concurrency_TRACE)
+            Tracer::tFlowId flowId { Tracer::NoFlowId };
+#endif /// Darkness_Concurrency_TRACE
+            [[no_unique_address]] tPostLocation location {};
+        };
+
+        using tQueuedTask = _QueuedTask;
+#else
+        using tQueuedTask = tTask;
+#endif /// Darkness_Concurrency_Queue_WRAPPED_TASKS
+
+#if defined(Darkness_Concurrency_Queue_METRICS)
+
+        /// @brief LatencyHistogram which is filled by several threads without a lock.
+        struct _AtomicHistogram final
+        {
+            void Add(std::chrono::nanoseconds duration) noexcept;
+
+            void CopyTo(LatencyHistogram& histogram) const noexcept;
+
+            std::array<std::atomic<std::uint64_t>, LatencyHistogram::BucketsCount> buckets {};
+            std::atomic<std::uint64_t> total { 0 };
+        };
+
+        /// @short Producers and workers update different cache lines.
+        struct _Metrics final
+        {
+            alignas(CacheLineSize) std::atomic<std::uint64_t> enqueued { 0 };
+            std::atomic<std::uint64_t> peakDepth { 0 };
+            alignas(CacheLineSize) std::atomic<std::uint64_t> executed { 0 };
+            std::atomic<std::uint64_t> dropped { 0 };
+            _AtomicHistogram waitTime;
+            _AtomicHistogram serviceTime;
+        };
+#endif /// Darkness_Concurrency_Queue_METRICS
+
+        using tTaskQueue = MpscQueue<tQueuedTask>;
+        using tTaskBatch = std::vector<tQueuedTask>;
+        using tWakeSignal = std::uint32_t;
+
+        /// @short m_Sleepers keeps the parked workers in the low half and the parked workers which producers have
+        ///        claimed to wake up in the high half, so a woken worker knows whether it should take a claim.
+        static constexpr std::uint32_t const _SleepersMask = 0xFFFF;
+        static constexpr std::uint32_t const _Claim = _SleepersMask + 1;
 
     public:
         struct IExecutionPolicy
@@ -33,6 +112,13 @@ namespace Darkness::Concurrency {
             virtual bool RequestStop() = 0;
 
             [[nodiscard]] virtual std::stop_token GetStopToken() const noexcept = 0;
+
+            /// @brief Gives a chance to keep the task posted from a worker of this policy on this worker.
+            /// @return true if the task has been taken.
+            [[nodiscard]] virtual bool TryPostFromWorker([[maybe_unused]] tQueuedTask& task)
+            {
+                return false;
+            }
         };
 
         using tExecutionPolicyPtr = std::unique_ptr<IExecutionPolicy>;
@@ -63,9 +149,62 @@ namespace Darkness::Concurrency {
             std::jthread m_Worker {};
         };
 
+        /// @brief The queue is serviced by several workers. Each worker has its own deque of tasks and steals tasks
+        ///        from the siblings when idle.
+        /// @short Tasks posted from outside go through the shared task queue, a worker takes a batch from it and
+        ///        keeps the rest of the batch in its own deque. Tasks posted from a worker go to its own deque.
+        ///        The execution order of tasks is not guaranteed. GetWorkThreadId returns the id of the first worker.
+        class ThreadPoolExecutionPolicy final : public IExecutionPolicy
+        {
+            struct alignas(CacheLineSize) _Worker final
+            {
+                Spinlock access;
+                std::deque<tQueuedTask> tasks;
+                std::atomic<std::size_t> size { 0 };
+                tTaskBatch batch;
+            };
+
+            using tWorkerPtr = std::unique_ptr<_Worker>;
+            using tWorkerLock = std::lock_guard<Spinlock> const;
+
+        public:
+            /// @param workersCount Zero means the number of hardware threads.
+            explicit ThreadPoolExecutionPolicy(std::size_t workersCount);
+
+            ~ThreadPoolExecutionPolicy() override;
+
+            void Start(Queue* queue) override;
+
+            bool RequestStop() override;
+
+            [[nodiscard]] std::stop_token GetStopToken() const noexcept override;
+
+            [[nodiscard]] bool TryPostFromWorker(tQueuedTask& task) override;
+
+        private:
+            void _Routine(Queue* queue, std::size_t index) noexcept;
+
+            [[nodiscard]] bool _TryPopLocal(std::size_t index, tQueuedTask& task);
+
+            [[nodiscard]] bool _TryPopShared(Queue* queue, std::size_t index, tQueuedTask& task);
+
+            [[nodiscard]] bool _TrySteal(std::size_t index, tQueuedTask& task);
+
+            [[nodiscard]] bool _HasWork(Queue* queue);
+
+            void _PushLocal(_Worker& worker, tQueuedTask&& task);
+
+        private:
+            std::vector<tWorkerPtr> m_Workers;
+            std::vector<std::jthread> m_Threads;
+            std::stop_source m_StopSource;
+            std::mutex m_SharedAccess;
+            std::atomic<std::size_t> m_RunningCount { 0 };
+        };
+
     public:
         explicit Queue(std::string name, tExceptionHandler exceptionHandler
-                       , tExecutionPolicyPtr executionPolicy) noexcept;
+                       , tExecutionPolicyPtr executionPolicy, QueueOptions const& options = {}) noexcept;
 
         ~Queue() override;
 
@@ -83,14 +222,16 @@ namespace Darkness::Concurrency {
 
         [[nodiscard]] eAsyncState GetState() const noexcept override;
 
-        void Post(tTask&& task) override;
+        void Post(tTask&& task, tPostLocation location = tPostLocation::current()) override;
 
-        void Post(tTask const& task) override;
+        void PostBatch(std::span<tTask> tasks, tPostLocation location = tPostLocation::current()) override;
 
         [[nodiscard]] std::thread::id GetWorkThreadId() const noexcept override;
 
         [[nodiscard]] std::string const& GetName() const noexcept override;
 
+        [[nodiscard]] QueueMetrics GetMetrics() const noexcept override;
+
     private:
         void _Stop();
 
@@ -98,15 +239,60 @@ namespace Darkness::Concurrency {
 
         void _Routine(std::stop_token stopToken) noexcept;
 
+        /// @brief Applies the attributes to the current worker thread.
+        void _ApplyThreadAttributes(ThreadAttributes const& attributes) const noexcept;
+
+        void _Execute(tTask& task);
+
+#if defined(Darkness_Concurrency_Queue_WRAPPED_TASKS)
+        /// @brief Wraps the task before it is posted.
+        [[nodiscard]] _QueuedTask _Wrap(tTask&& task, tPostLocation const& location) noexcept;
+
+        /// @brief Executes the task and records its metrics and trace events.
+        void _Execute(_QueuedTask& task);
+#else
+        [[nodiscard]] static tTask&& _Wrap(tTask&& task, [[maybe_unused]] tPostLocation location) noexcept
+        {
+            return std::move(task);
+        }
+#endif /// Darkness_Concurrency_Queue_WRAPPED_TASKS
+
+        /// @brief Accounts tasks which are posted. Should be called before they become visible to the workers.
+        void _OnEnqueued(std::size_t count) noexcept;
+
+        /// @brief Accounts pending tasks which are dropped by the stop.
+        void _OnDropped(std::size_t count) noexcept;
+
+        /// @brief Wakes up a parked worker if any.
+        void _Notify() noexcept;
+
+        /// @brief Wakes up all parked workers.
+        void _NotifyAll() noexcept;
+
+        /// @brief Parks the worker until a new task or the stop request.
+        /// @param isIdle Checks that there is no work for the worker.
+        template<typename IdlePredicateT>
+        void _Park(std::stop_token const& stopToken, IdlePredicateT&& isIdle) noexcept;
+
+        /// @brief Removes the worker which leaves _Park from the sleepers.
+        void _Unpark() noexcept;
+
     private:
         std::string const m_Name;
         tExceptionHandler const m_ExceptionHandler;
+        QueueOptions const m_Options;
         tExecutionPolicyPtr m_ExecutionPolicy;
         std::atomic<eAsyncState> m_State;
         std::atomic<std::thread::id> m_Id;
         tTaskQueue m_TaskQueue;
-        std::condition_variable m_Condition;
-        std::mutex m_Mutex;
+        alignas(CacheLineSize) std::atomic<std::uint32_t> m_Sleepers;
+        std::atomic<tWakeSignal> m_WakeSignal;
+#if defined(Darkness_Concurrency_Queue_METRICS)
+        _Metrics m_Metrics;
+#endif /// Darkness_Concurrency_Queue_METRICS
+#if defined(Darkness_Concurrency_TRACE)
+        Tracer::tNameId const m_TraceNameId;
+#endif /// Darkness_Concurrency_TRACE
     };
 } /// end namespace Darkness::Concurrency
 
@@ -9,64 +9,250 @@
 
 #include <Darkness/Concurrency/QueueManager.hpp>
 #include "Queue.hpp"
+#include "QueueTable.hpp"
 
+#include <Darkness/Concurrency/Spinlock.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string_view>
 #include <unordered_map>
 #include <mutex>
+#include <cassert>
+#include <vector>
 
 namespace Darkness::Concurrency {
     class QueueManager::_Impl final
     {
-        using tQueueStore = std::unordered_map<std::string, tQueuePtr>;
+        /// @short Allows lookup by std::string_view without construction of std::string.
+        struct _NameHash final
+        {
+            using is_transparent = void;
+
+            [[nodiscard]] std::size_t operator()(std::string_view name) const noexcept
+            {
+                return std::hash<std::string_view> {}(name);
+            }
+        };
+
+        struct _StoredQueue final
+        {
+            tQueuePtr queue;
+            QueueHandle handle;
+        };
+
+        struct _SnapshotQueue final
+        {
+            tQueueWeakPtr queue;
+            QueueHandle handle;
+        };
+
+        using tQueueStore = std::unordered_map<std::string, _StoredQueue, _NameHash, std::equal_to<>>;
+
+        /// @brief Immutable copy of the registry for readers. Is replaced entirely on every change.
+        using tSnapshot = std::unordered_map<std::string, _SnapshotQueue, _NameHash, std::equal_to<>> const;
+        using tSnapshotPtr = std::shared_ptr<tSnapshot>;
+
+        /// @brief The snapshot which is used by the thread and the version it belongs to.
+        struct _ReaderCache final
+        {
+            std::uint64_t version { 0 };
+            tSnapshotPtr snapshot;
+        };
+
+        using tNamedQueueMetrics = QueueManager::tNamedQueueMetrics;
 
         using tAccess = std::mutex;
         using tLock = std::lock_guard<tAccess> const;
+        using tSnapshotLock = std::lock_guard<Spinlock> const;
 
     public:
-        [[nodiscard]] bool _IsExists(std::string const& name) const noexcept
+        _Impl()
+            : m_Snapshot(std::make_shared<tSnapshot>())
+              , m_Table(QueueTable::Instance())
         {
-            tLock lock(m_Access);
-            return m_QueuesStore.contains(name);
+        }
+
+        ~_Impl()
+        {
+            _KillAndForgetAll();
+        }
+
+        [[nodiscard]] bool _IsExists(std::string_view name) const noexcept
+        {
+            return _Find(name) != nullptr;
+        }
+
+        [[nodiscard]] QueueHandle _GetHandleByName(std::string_view name) const noexcept
+        {
+            auto const* const found = _Find(name);
+            return found ? found->handle : QueueHandle {};
         }
 
         [[nodiscard]] tQueueWeakPtr _CreateOrGetBackgroundQueueByName(
-            std::string const& name, tExceptionHandler const& exceptionHandler)
+            std::string_view name, tExceptionHandler const& exceptionHandler, QueueOptions const& options)
         {
-            tLock lock(m_Access);
+            return _CreateOrGet(name, exceptionHandler, options, [name]() -> Queue::tExecutionPolicyPtr {
+                if (name == QueueManager::mainQueueName)
+                {
+                    return std::make_unique<Queue::MainThreadExecutionPolicy>();
+                }
 
-            auto found = m_QueuesStore.find(name);
-            if (found == m_QueuesStore.end())
+                return std::make_unique<Queue::BackgroundThreadExecutionPolicy>();
+            });
+        }
+
+        [[nodiscard]] tQueueWeakPtr _CreateOrGetThreadPoolQueueByName(
+            std::string_view name, std::size_t workersCount, tExceptionHandler const& exceptionHandler
+            , QueueOptions const& options)
+        {
+            assert(name != QueueManager::mainQueueName && "Bad logic! The main queue can not be a pool!");
+
+            return _CreateOrGet(name, exceptionHandler, options, [workersCount]() -> Queue::tExecutionPolicyPtr {
+                return std::make_unique<Queue::ThreadPoolExecutionPolicy>(workersCount);
+            });
+        }
+
+        void _ForgetByName(std::string_view name)
+        {
+            tQueuePtr forgotten;
             {
-                Queue::tExecutionPolicyPtr executionPolicy;
-                if (name == QueueManager::mainQueueName)
+                tLock lock(m_Access);
+                auto found = m_QueuesStore.find(name);
+                if (found == m_QueuesStore.end())
+                {
+                    return;
+                }
+
+                m_Table.Unregister(found->second.handle);
+                forgotten = std::move(found->second.queue);
+                m_QueuesStore.erase(found);
+                _Publish();
+            }
+
+            /// @short The queue is destroyed (and its thread is joined) outside the lock.
+            forgotten.reset();
+        }
+
+        void _KillAndForgetAll()
+        {
+            tQueueStore forgotten;
+            {
+                tLock lock(m_Access);
+                for (auto const& [name, stored] : m_QueuesStore)
                 {
-                    executionPolicy = std::make_unique<Queue::MainThreadExecutionPolicy>();
+                    m_Table.Unregister(stored.handle);
                 }
-                else
+
+                forgotten.swap(m_QueuesStore);
+                _Publish();
+            }
+
+            forgotten.clear();
+        }
+
+        [[nodiscard]] tNamedQueueMetrics _CollectMetrics() const
+        {
+            tSnapshotPtr const snapshot = _LoadSnapshot();
+
+            tNamedQueueMetrics collected;
+            collected.reserve(snapshot->size());
+            for (auto const& [name, stored] : *snapshot)
+            {
+                if (auto const queue = stored.queue.lock())
                 {
-                    executionPolicy = std::make_unique<Queue::BackgroundThreadExecutionPolicy>();
+                    collected.emplace_back(name, queue->GetMetrics());
                 }
+            }
 
-                return m_QueuesStore[name] = std::make_shared<Queue>(
-                    name, exceptionHandler, std::move(executionPolicy));
+            std::sort(collected.begin(), collected.end(), [](auto const& left, auto const& right) {
+                return left.first < right.first;
+            });
+            return collected;
+        }
+
+    private:
+        /// @short The read path: one atomic load of the version and a lookup, no lock and no allocation.
+        ///        Every thread owns the snapshot it reads and replaces it only when the version changes. So a replaced
+        ///        snapshot is freed by the last thread which reads it again, at most one stale snapshot per thread.
+        [[nodiscard]] _SnapshotQueue const* _Find(std::string_view name) const noexcept
+        {
+            thread_local _ReaderCache cache;
+
+            std::uint64_t const version = m_Version.load(std::memory_order_acquire);
+            if (cache.version != version)
+            {
+                cache.snapshot = _LoadSnapshot();
+                cache.version = version;
             }
 
-            return found->second;
+            auto const found = cache.snapshot->find(name);
+            return found != cache.snapshot->end() ? &found->second : nullptr;
         }
 
-        void _ForgetByName(std::string const& name)
+        [[nodiscard]] tSnapshotPtr _LoadSnapshot() const noexcept
         {
-            tLock lock(m_Access);
-            m_QueuesStore.erase(name);
+            tSnapshotLock lock(m_SnapshotAccess);
+            return m_Snapshot;
         }
 
-        void _KillAndForgetAll()
+        template<typename ExecutionPolicyFactoryT>
+        [[nodiscard]] tQueueWeakPtr _CreateOrGet(std::string_view name, tExceptionHandler const& exceptionHandler
+                                                 , QueueOptions const& options
+                                                 , ExecutionPolicyFactoryT&& executionPolicyFactory)
         {
+            if (auto const* const found = _Find(name))
+            {
+                return found->queue;
+            }
+
             tLock lock(m_Access);
-            m_QueuesStore.clear();
+
+            auto found = m_QueuesStore.find(name);
+            if (found == m_QueuesStore.end())
+            {
+                std::string key(name);
+                auto queue = std::make_shared<Queue>(key, exceptionHandler, executionPolicyFactory(), options);
+                QueueHandle const handle = m_Table.Register(queue.get());
+                found = m_QueuesStore.emplace(std::move(key), _StoredQueue { std::move(queue), handle }).first;
+                _Publish();
+            }
+
+            return found->second.queue;
+        }
+
+        /// @brief Replaces the snapshot by a copy of the store. Should be called under m_Access.
+        /// @short Readers may still use the previous snapshot, it is freed when the last of them releases it.
+        ///        The version is changed after the snapshot, so a reader which sees it loads the new snapshot. The lock
+        ///        of the snapshot is taken by a reader only once per change.
+        void _Publish()
+        {
+            auto snapshot = std::make_shared<std::remove_const_t<tSnapshot>>();
+            snapshot->reserve(m_QueuesStore.size());
+            for (auto const& [name, stored] : m_QueuesStore)
+            {
+                snapshot->emplace(name, _SnapshotQueue { stored.queue, stored.handle });
+            }
+
+            /// @short The previous snapshot is released outside the lock.
+            tSnapshotPtr published = std::move(snapshot);
+            {
+                tSnapshotLock lock(m_SnapshotAccess);
+                m_Snapshot.swap(published);
+            }
+
+            m_Version.fetch_add(1, std::memory_order_release);
         }
 
     private:
         tQueueStore m_QueuesStore;
+        tSnapshotPtr m_Snapshot;
+        Spinlock mutable m_SnapshotAccess;
+        std::atomic<std::uint64_t> m_Version { 1 };
+        QueueTable& m_Table;
         tAccess mutable m_Access;
     };
 
@@ -78,28 +264,42 @@ namespace Darkness::Concurrency {
         return instance;
     }
 
-    tQueueWeakPtr QueueManager::CreateOrGetBackgroundQueueByName(std::string const& name
-                                                                 , tExceptionHandler const& exceptionHandler) const
+    tQueueWeakPtr QueueManager::CreateOrGetBackgroundQueueByName(std::string_view name
+                                                                 , tExceptionHandler const& exceptionHandler
+                                                                 , QueueOptions const& options) const
+    {
+        return m_Impl->_CreateOrGetBackgroundQueueByName(name, exceptionHandler, options);
+    }
+
+    tQueueWeakPtr QueueManager::CreateOrGetThreadPoolQueueByName(std::string_view name, std::size_t workersCount
+                                                                 , tExceptionHandler const& exceptionHandler
+                                                                 , QueueOptions const& options) const
     {
-        return m_Impl->_CreateOrGetBackgroundQueueByName(name, exceptionHandler);
+        return m_Impl->_CreateOrGetThreadPoolQueueByName(name, workersCount, exceptionHandler, options);
     }
 
-    bool QueueManager::IsExists(std::string const& name) const noexcept
+    bool QueueManager::IsExists(std::string_view name) const noexcept
     {
         return m_Impl->_IsExists(name);
     }
 
+    QueueHandle QueueManager::GetHandleByName(std::string_view name) const noexcept
+    {
+        return m_Impl->_GetHandleByName(name);
+    }
+
     bool QueueManager::IsMainExists() const noexcept
     {
         return IsExists(mainQueueName);
     }
 
-    tQueueWeakPtr QueueManager::CreateOrGetMainQueue(tExceptionHandler const& exceptionHandler) const
+    tQueueWeakPtr QueueManager::CreateOrGetMainQueue(tExceptionHandler const& exceptionHandler
+                                                     , QueueOptions const& options) const
     {
-        return CreateOrGetBackgroundQueueByName(mainQueueName, exceptionHandler);
+        return CreateOrGetBackgroundQueueByName(mainQueueName, exceptionHandler, options);
     }
 
-    void QueueManager::ForgetByName(std::string const& name) const
+    void QueueManager::ForgetByName(std::string_view name) const
     {
         m_Impl->_ForgetByName(name);
     }
@@ -114,6 +314,11 @@ namespace Darkness::Concurrency {
         m_Impl->_KillAndForgetAll();
     }
 
+    QueueManager::tNamedQueueMetrics QueueManager::CollectMetrics() const
+    {
+        return m_Impl->_CollectMetrics();
+    }
+
     QueueManager::QueueManager() noexcept
         : m_Impl(std::make_unique<_Impl>())
     {
@@ -0,0 +1,51 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    QueueMetrics.cpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Implementation of @struct LatencyHistogram
+
+#include <Darkness/Concurrency/QueueMetrics.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+namespace Darkness::Concurrency {
+    std::chrono::nanoseconds LatencyHistogram::GetPercentile(double fraction) const noexcept
+    {
+        if (count == 0)
+        {
+            return std::chrono::nanoseconds(0);
+        }
+
+        auto const rank = static_cast<std::uint64_t>(std::ceil(fraction * double(count)));
+        std::uint64_t accumulated = 0;
+        for (std::size_t index = 0; index < BucketsCount; ++index)
+        {
+            accumulated += buckets[index];
+            if (accumulated >= rank && accumulated != 0)
+            {
+                /// @short The upper bound of the bucket, the last two buckets are clamped to the range of nanoseconds.
+                std::uint64_t const bound = index + 1 < BucketsCount ? (std::uint64_t(1) << (index + 1)) - 1
+                                                                     : UINT64_MAX;
+                return std::chrono::nanoseconds(static_cast<std::int64_t>(std::min<std::uint64_t>(bound, INT64_MAX)));
+            }
+        }
+
+        return std::chrono::nanoseconds(INT64_MAX);
+    }
+
+    std::chrono::nanoseconds LatencyHistogram::GetMean() const noexcept
+    {
+        return count != 0 ? total / static_cast<std::int64_t>(count) : std::chrono::nanoseconds(0);
+    }
+
+    std::size_t LatencyHistogram::GetBucketIndex(std::uint64_t nanoseconds) noexcept
+    {
+        return nanoseconds < 2 ? 0 : std::size_t(std::bit_width(nanoseconds) - 1);
+    }
+} /// end namespace Darkness::Concurrency
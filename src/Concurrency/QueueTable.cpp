@@ -0,0 +1,127 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    QueueTable.cpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Implementation of @class QueueTable and @class QueueHandle
+
+#include "QueueTable.hpp"
+
+#include <Darkness/Concurrency/Utilities.hpp>
+
+#include <cassert>
+
+namespace Darkness::Concurrency {
+    /// @short Owns the hazard record of the thread and returns it back on the thread exit.
+    struct QueueTable::_HazardRecordOwner final
+    {
+        ~_HazardRecordOwner()
+        {
+            if (record)
+            {
+                record->owned.store(false, std::memory_order_release);
+            }
+        }
+
+        _HazardRecord* record { nullptr };
+        bool isClaimed { false };
+    };
+
+    QueueTable& QueueTable::Instance()
+    {
+        static QueueTable instance;
+        return instance;
+    }
+
+    QueueTable::QueueTable() noexcept
+    {
+        m_FreeSlots.reserve(_SlotsCount);
+        for (std::uint32_t index = _SlotsCount; index != 0; --index)
+        {
+            m_FreeSlots.push_back(index - 1);
+        }
+    }
+
+    QueueHandle QueueTable::Register(IQueue* queue)
+    {
+        assert(queue && "Bad data!");
+
+        tLock lock(m_Access);
+        if (m_FreeSlots.empty())
+        {
+            return {};
+        }
+
+        std::uint32_t const index = m_FreeSlots.back();
+        m_FreeSlots.pop_back();
+
+        _Slot& slot = m_Slots[index];
+        slot.queue.store(queue, std::memory_order_release);
+        return { index, slot.generation.load(std::memory_order_relaxed) };
+    }
+
+    void QueueTable::Unregister(QueueHandle handle) noexcept
+    {
+        if (!handle.IsValid() || handle.m_Index >= _SlotsCount)
+        {
+            return;
+        }
+
+        tLock lock(m_Access);
+
+        _Slot& slot = m_Slots[handle.m_Index];
+        std::uint32_t expected = handle.m_Generation;
+        std::uint32_t const next = expected + 1 != 0 ? expected + 1 : 1; /// Zero is reserved for invalid handles.
+        if (!slot.generation.compare_exchange_strong(expected, next, std::memory_order_seq_cst))
+        {
+            return;
+        }
+
+        for (auto const& hazard : m_HazardRecords)
+        {
+            while (hazard.slot.load(std::memory_order_seq_cst) == handle.m_Index)
+            {
+                CpuRelax();
+            }
+        }
+
+        slot.queue.store(nullptr, std::memory_order_relaxed);
+        m_FreeSlots.push_back(handle.m_Index);
+    }
+
+    QueueTable::_HazardRecord* QueueTable::_GetCurrentThreadHazard() noexcept
+    {
+        thread_local _HazardRecordOwner owner;
+        if (!owner.isClaimed)
+        {
+            owner.isClaimed = true;
+            for (auto& hazard : m_HazardRecords)
+            {
+                bool expected = false;
+                if (hazard.owned.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                {
+                    owner.record = &hazard;
+                    break;
+                }
+            }
+        }
+
+        return owner.record;
+    }
+
+    bool QueueHandle::Post(tTask&& task, tPostLocation location) const
+    {
+        return QueueTable::Instance().Post(*this, [&task, location](IQueue& queue) {
+            queue.Post(std::move(task), location);
+        });
+    }
+
+    bool QueueHandle::PostBatch(std::span<tTask> tasks, tPostLocation location) const
+    {
+        return QueueTable::Instance().Post(*this, [tasks, location](IQueue& queue) {
+            queue.PostBatch(tasks, location);
+        });
+    }
+} /// end namespace Darkness::Concurrency
@@ -0,0 +1,125 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    QueueTable.hpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Declaration of @class QueueTable. The table of queues which are addressed by QueueHandle.
+///          @short A poster publishes the slot index in its hazard record and then validates the generation.
+///                 Unregistration changes the generation first and then waits until no hazard record refers to
+///                 the slot, so a queue is never used after it is unregistered.
+
+#pragma once
+
+#include <Darkness/Concurrency/IQueue.hpp>
+#include <Darkness/Concurrency/QueueHandle.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace Darkness::Concurrency {
+    class QueueTable final
+    {
+        struct _Slot final
+        {
+            std::atomic<std::uint32_t> generation { 1 };
+            std::atomic<IQueue*> queue { nullptr };
+        };
+
+        struct alignas(CacheLineSize) _HazardRecord final
+        {
+            std::atomic<std::uint32_t> slot { _NoSlot }; /// The protected slot index or _NoSlot.
+            std::atomic<bool> owned { false };
+        };
+
+        struct _HazardRecordOwner;
+
+        /// @brief Withdraws the published slot even if the post throws, otherwise Unregister would wait forever.
+        class _HazardGuard final
+        {
+        public:
+            explicit _HazardGuard(_HazardRecord& record) noexcept
+                : m_Record(record)
+            {
+            }
+
+            _HazardGuard(_HazardGuard const&) = delete;
+            _HazardGuard& operator=(_HazardGuard const&) = delete;
+
+            ~_HazardGuard()
+            {
+                m_Record.slot.store(_NoSlot, std::memory_order_release);
+            }
+
+        private:
+            _HazardRecord& m_Record;
+        };
+
+        using tAccess = std::mutex;
+        using tLock = std::lock_guard<tAccess> const;
+
+    public:
+        [[nodiscard]] static QueueTable& Instance();
+
+        /// @brief Registers the queue. It should stay alive till Unregister.
+        /// @return The invalid handle if the table is full.
+        [[nodiscard]] QueueHandle Register(IQueue* queue);
+
+        /// @brief Invalidates all handles of the queue and waits for the posts which are in progress.
+        void Unregister(QueueHandle handle) noexcept;
+
+        template<typename PostT>
+        bool Post(QueueHandle handle, PostT&& post)
+        {
+            if (handle.m_Index >= _SlotsCount)
+            {
+                return false;
+            }
+
+            _Slot& slot = m_Slots[handle.m_Index];
+            _HazardRecord* const hazard = _GetCurrentThreadHazard();
+            if (!hazard)
+            {
+                /// @short All hazard records are taken, the table lock protects the queue instead.
+                tLock lock(m_Access);
+                if (slot.generation.load(std::memory_order_relaxed) != handle.m_Generation)
+                {
+                    return false;
+                }
+
+                post(*slot.queue.load(std::memory_order_relaxed));
+                return true;
+            }
+
+            hazard->slot.store(handle.m_Index, std::memory_order_seq_cst);
+            _HazardGuard const guard(*hazard);
+            if (slot.generation.load(std::memory_order_seq_cst) != handle.m_Generation)
+            {
+                return false;
+            }
+
+            post(*slot.queue.load(std::memory_order_acquire));
+            return true;
+        }
+
+    private:
+        QueueTable() noexcept;
+
+        [[nodiscard]] _HazardRecord* _GetCurrentThreadHazard() noexcept;
+
+        static constexpr std::uint32_t const _SlotsCount = 4096;
+        static constexpr std::uint32_t const _HazardRecordsCount = 256;
+        static constexpr std::uint32_t const _NoSlot = ~std::uint32_t(0);
+
+    private:
+        std::array<_Slot, _SlotsCount> m_Slots {};
+        std::array<_HazardRecord, _HazardRecordsCount> m_HazardRecords {};
+        std::vector<std::uint32_t> m_FreeSlots;
+        tAccess m_Access;
+    };
+} /// end namespace Darkness::Concurrency
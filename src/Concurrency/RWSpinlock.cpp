@@ -0,0 +1,158 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    RWSpinlock.cpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Implementation of @class RWSpinlock
+
+#include "Darkness/Concurrency/RWSpinlock.hpp"
+#include "Darkness/Concurrency/Utilities.hpp"
+
+namespace Darkness::Concurrency {
+    namespace {
+        /// @short The stripe of a thread is assigned once, so lock_shared and unlock_shared always meet.
+        std::size_t _GetCurrentThreadStripe() noexcept
+        {
+            static std::atomic<std::size_t> nextStripe { 0 };
+            thread_local std::size_t const stripe = nextStripe.fetch_add(1, std::memory_order_relaxed);
+            return stripe;
+        }
+    } /// end unnamed namespace
+
+    RWSpinlock::RWSpinlock() noexcept = default;
+
+    void RWSpinlock::lock() noexcept
+    {
+        for (std::uint32_t round = 0; !_TryAcquireWriter(); ++round)
+        {
+            if (round < _SpinRounds)
+            {
+                CpuRelax();
+                continue;
+            }
+
+            _WaitForWriter();
+        }
+
+        _WaitForReaders();
+    }
+
+    bool RWSpinlock::try_lock() noexcept
+    {
+        if (!_TryAcquireWriter())
+        {
+            return false;
+        }
+
+        for (auto const& stripe : m_Readers)
+        {
+            if (stripe.count.load(std::memory_order_seq_cst) != 0)
+            {
+                unlock();
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void RWSpinlock::unlock() noexcept
+    {
+        m_Writer.store(0, std::memory_order_seq_cst);
+        if (m_ParkedCount.load(std::memory_order_seq_cst) != 0)
+        {
+            m_Writer.notify_all();
+        }
+    }
+
+    void RWSpinlock::lock_shared() noexcept
+    {
+        for (std::uint32_t round = 0; !try_lock_shared(); ++round)
+        {
+            if (round < _SpinRounds)
+            {
+                CpuRelax();
+                continue;
+            }
+
+            _WaitForWriter();
+        }
+    }
+
+    bool RWSpinlock::try_lock_shared() noexcept
+    {
+        if (m_Writer.load(std::memory_order_relaxed) != 0)
+        {
+            return false;
+        }
+
+        std::atomic<tCounter>& readersCount = _GetReadersCount();
+        readersCount.fetch_add(1, std::memory_order_seq_cst);
+        if (m_Writer.load(std::memory_order_seq_cst) == 0)
+        {
+            return true;
+        }
+
+        /// @short A writer came in between, it has the priority.
+        unlock_shared();
+        return false;
+    }
+
+    void RWSpinlock::unlock_shared() noexcept
+    {
+        std::atomic<tCounter>& readersCount = _GetReadersCount();
+        if (readersCount.fetch_sub(1, std::memory_order_seq_cst) == 1
+            && m_Writer.load(std::memory_order_seq_cst) != 0)
+        {
+            readersCount.notify_all();
+        }
+    }
+
+    bool RWSpinlock::_TryAcquireWriter() noexcept
+    {
+        tCounter expected = 0;
+        return m_Writer.load(std::memory_order_relaxed) == 0
+               && m_Writer.compare_exchange_strong(expected, 1, std::memory_order_seq_cst);
+    }
+
+    std::atomic<RWSpinlock::tCounter>& RWSpinlock::_GetReadersCount() noexcept
+    {
+        return m_Readers[_GetCurrentThreadStripe() % _StripesCount].count;
+    }
+
+    void RWSpinlock::_WaitForWriter() noexcept
+    {
+        m_ParkedCount.fetch_add(1, std::memory_order_seq_cst);
+        for (tCounter writer = m_Writer.load(std::memory_order_seq_cst); writer != 0
+             ; writer = m_Writer.load(std::memory_order_seq_cst))
+        {
+            m_Writer.wait(writer, std::memory_order_seq_cst);
+        }
+
+        m_ParkedCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /// @short The writer owns m_Writer already, so no new reader can come in. A stripe can still be raised by a reader
+    ///        in try_lock_shared, but such a reader sees the writer flag and backs out, so each stripe reaches zero.
+    void RWSpinlock::_WaitForReaders() noexcept
+    {
+        for (auto& stripe : m_Readers)
+        {
+            std::uint32_t round = 0;
+            for (tCounter count = stripe.count.load(std::memory_order_seq_cst); count != 0
+                 ; count = stripe.count.load(std::memory_order_seq_cst), ++round)
+            {
+                if (round < _SpinRounds)
+                {
+                    CpuRelax();
+                }
+                else
+                {
+                    stripe.count.wait(count, std::memory_order_seq_cst);
+                }
+            }
+        }
+    }
+} /// namespace Darkness::Concurrency
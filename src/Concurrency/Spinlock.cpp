@@ -8,20 +8,62 @@
 /// @brief   Implementation of @class Spinlock
 
 #include "Darkness/Concurrency/Spinlock.hpp"
+#include "Darkness/Concurrency/Utilities.hpp"
+
+#include <algorithm>
 
 namespace Darkness::Concurrency {
-    Spinlock::Spinlock() noexcept
+    Spinlock::Spinlock() noexcept = default;
+
+    void Spinlock::lock() noexcept
     {
-        m_Flag.clear();
+        std::uint32_t expected = _Unlocked;
+        if (!m_State.compare_exchange_strong(expected, _Locked, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            _LockContended();
+        }
     }
 
-    void Spinlock::lock() noexcept
+    bool Spinlock::try_lock() noexcept
     {
-        while (m_Flag.test_and_set(std::memory_order_acquire)) {} /// spin
+        std::uint32_t expected = _Unlocked;
+        return m_State.load(std::memory_order_relaxed) == _Unlocked
+               && m_State.compare_exchange_strong(expected, _Locked, std::memory_order_acquire
+                                                  , std::memory_order_relaxed);
     }
 
     void Spinlock::unlock() noexcept
     {
-        m_Flag.clear(std::memory_order_release);
+        if (m_State.exchange(_Unlocked, std::memory_order_release) == _LockedWithParkedWaiters)
+        {
+            m_State.notify_one();
+        }
+    }
+
+    void Spinlock::_LockContended() noexcept
+    {
+        std::uint32_t pauses = 1;
+        for (std::uint32_t round = 0; round < _SpinRounds; ++round)
+        {
+            for (std::uint32_t i = 0; i < pauses; ++i)
+            {
+                CpuRelax();
+            }
+
+            pauses = std::min(pauses * 2, _MaxPausesPerRound);
+
+            /// @short The write is tried only when the lock looks free.
+            if (m_State.load(std::memory_order_relaxed) == _Unlocked && try_lock())
+            {
+                return;
+            }
+        }
+
+        /// @short The parked contender takes the lock marked with waiters, because it can not know whether it was
+        ///        the last one. The cost is one extra notify on unlock.
+        while (m_State.exchange(_LockedWithParkedWaiters, std::memory_order_acquire) != _Unlocked)
+        {
+            m_State.wait(_LockedWithParkedWaiters, std::memory_order_relaxed);
+        }
     }
 } /// namespace Darkness::Concurrency
@@ -0,0 +1,361 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    TaskProfiler.cpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Implementation of @class TaskProfiler
+
+#include <Darkness/Concurrency/TaskProfiler.hpp>
+#include <Darkness/Concurrency/Spinlock.hpp>
+#include <Darkness/Common/Utilities.hpp>
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+
+#if defined(__linux__)
+#include <ctime>
+#endif
+
+namespace Darkness::Concurrency {
+    namespace {
+        constexpr std::uint32_t const DefaultSamplingPeriod = 64;
+        constexpr std::uint64_t const GoldenRatio = 0x9E3779B97F4A7C15;
+
+        /// @short The strings of std::source_location are literals, so the pointers identify the place.
+        struct SiteKey final
+        {
+            friend bool operator==(SiteKey const&, SiteKey const&) noexcept = default;
+
+            char const* fileName;
+            char const* functionName;
+            std::uint32_t line;
+            std::uint32_t column;
+        };
+
+        struct SiteKeyHash final
+        {
+            [[nodiscard]] std::size_t operator()(SiteKey const& key) const noexcept
+            {
+                std::size_t seed = 0;
+                Common::HashCombine(seed, key.fileName, key.functionName, key.line, key.column);
+                return seed;
+            }
+        };
+
+        /// @short The counts and times are already multiplied by the weights of the samples.
+        struct SiteAccumulator final
+        {
+            std::uint64_t samplesCount = 0;
+            std::uint64_t estimatedCount = 0;
+            std::chrono::nanoseconds estimatedCpuTime { 0 };
+            std::chrono::nanoseconds estimatedWallTime { 0 };
+            std::chrono::nanoseconds maxWallTime { 0 };
+        };
+
+        /// @brief The samples of one thread. The lock is taken by the report only, so it is not contended.
+        struct ThreadProfile final
+        {
+            using tSites = std::unordered_map<SiteKey, SiteAccumulator, SiteKeyHash>;
+
+            Spinlock access;
+            tSites sites;
+        };
+
+        using tThreadProfilePtr = std::shared_ptr<ThreadProfile>;
+
+        [[nodiscard]] std::chrono::nanoseconds GetThreadCpuTime() noexcept
+        {
+#if defined(__linux__)
+            timespec time {};
+            clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+            return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+#else
+            /// @short The per-thread CPU clocks of other systems are too coarse, the wall time is used instead.
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch());
+#endif
+        }
+    } /// end unnamed namespace
+
+    class TaskProfiler::_Impl final
+    {
+        struct _ThreadState final
+        {
+            tThreadProfilePtr profile;
+            std::uint32_t countdown { 0 };
+
+            /// @brief The state of the xorshift generator of the intervals, zero till the first draw.
+            std::uint64_t random { 0 };
+        };
+
+        using tLock = std::lock_guard<std::mutex> const;
+        using tProfileLock = std::lock_guard<Spinlock> const;
+
+    public:
+        void _SetSamplingPeriod(std::uint32_t period) noexcept
+        {
+            m_SamplingPeriod.store(std::max<std::uint32_t>(period, 1), std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] std::uint32_t _GetSamplingPeriod() const noexcept
+        {
+            return m_SamplingPeriod.load(std::memory_order_relaxed);
+        }
+
+        /// @return The weight of the sample if it is the turn of the current task, zero otherwise.
+        /// @short The interval till the next sample is uniform in [0, 2 * period - 2], so it is period on average.
+        [[nodiscard]] std::uint32_t _TakeSampleTurn() noexcept
+        {
+            _ThreadState& state = _GetThreadState();
+            if (state.countdown != 0)
+            {
+                --state.countdown;
+                return 0;
+            }
+
+            std::uint32_t const period = _GetSamplingPeriod();
+            state.countdown = period > 1 ? std::uint32_t(_NextRandom(state) % (2 * std::uint64_t(period) - 1)) : 0;
+            return period;
+        }
+
+        void _Account(std::source_location const& location, std::chrono::nanoseconds cpuTime
+                      , std::chrono::nanoseconds wallTime, std::uint32_t weight) noexcept
+        {
+            ThreadProfile* const profile = _GetThreadProfile();
+            if (!profile)
+            {
+                return;
+            }
+
+            SiteKey const key { location.file_name(), location.function_name(), location.line()
+                                , location.column() };
+            try
+            {
+                tProfileLock lock(profile->access);
+                SiteAccumulator& site = profile->sites[key];
+                ++site.samplesCount;
+                site.estimatedCount += weight;
+                site.estimatedCpuTime += cpuTime * weight;
+                site.estimatedWallTime += wallTime * weight;
+                site.maxWallTime = std::max(site.maxWallTime, wallTime);
+            }
+            catch (...)
+            {
+                /// @short The sample is lost if a new place can not be allocated.
+            }
+        }
+
+        [[nodiscard]] tReport _GetReport() const
+        {
+            std::vector<tThreadProfilePtr> profiles;
+            {
+                tLock lock(m_Access);
+                profiles = m_Profiles;
+            }
+
+            /// @short Places are merged by their values, the same literal can have different addresses in
+            ///        different translation units.
+            using tMergeKey = std::tuple<std::string_view, std::string_view, std::uint32_t>;
+            std::map<tMergeKey, SiteAccumulator> merged;
+            for (auto const& profile : profiles)
+            {
+                tProfileLock lock(profile->access);
+                for (auto const& [key, site] : profile->sites)
+                {
+                    SiteAccumulator& total = merged[tMergeKey(key.fileName, key.functionName, key.line)];
+                    total.samplesCount += site.samplesCount;
+                    total.estimatedCount += site.estimatedCount;
+                    total.estimatedCpuTime += site.estimatedCpuTime;
+                    total.estimatedWallTime += site.estimatedWallTime;
+                    total.maxWallTime = std::max(total.maxWallTime, site.maxWallTime);
+                }
+            }
+
+            tReport report;
+            report.reserve(merged.size());
+            for (auto const& [key, site] : merged)
+            {
+                TaskSiteStatistics& statistics = report.emplace_back();
+                statistics.fileName = std::get<0>(key);
+                statistics.functionName = std::get<1>(key);
+                statistics.line = std::get<2>(key);
+                statistics.samplesCount = site.samplesCount;
+                statistics.estimatedCount = site.estimatedCount;
+                statistics.estimatedCpuTime = site.estimatedCpuTime;
+                statistics.estimatedWallTime = site.estimatedWallTime;
+                statistics.maxWallTime = site.maxWallTime;
+            }
+
+            std::ranges::sort(report, [](TaskSiteStatistics const& left, TaskSiteStatistics const& right) {
+                return left.estimatedCpuTime > right.estimatedCpuTime;
+            });
+            return report;
+        }
+
+        void _Reset()
+        {
+            tLock lock(m_Access);
+            for (auto const& profile : m_Profiles)
+            {
+                tProfileLock profileLock(profile->access);
+                profile->sites.clear();
+            }
+
+            /// @short The profiles of finished threads are owned only by the list.
+            std::erase_if(m_Profiles, [](tThreadProfilePtr const& profile) {
+                return profile.use_count() == 1;
+            });
+        }
+
+    private:
+        [[nodiscard]] static _ThreadState& _GetThreadState() noexcept
+        {
+            thread_local _ThreadState state;
+            return state;
+        }
+
+        /// @short xorshift64, the threads are seeded by the distinct values of the golden ratio sequence.
+        [[nodiscard]] static std::uint64_t _NextRandom(_ThreadState& state) noexcept
+        {
+            static std::atomic<std::uint64_t> seed { 0 };
+            if (state.random == 0)
+            {
+                state.random = (seed.fetch_add(GoldenRatio, std::memory_order_relaxed) + GoldenRatio) | 1;
+            }
+
+            state.random ^= state.random << 13;
+            state.random ^= state.random >> 7;
+            state.random ^= state.random << 17;
+            return state.random;
+        }
+
+        /// @return nullptr if the profile can not be allocated.
+        [[nodiscard]] ThreadProfile* _GetThreadProfile() noexcept
+        {
+            _ThreadState& state = _GetThreadState();
+            if (!state.profile)
+            {
+                try
+                {
+                    auto profile = std::make_shared<ThreadProfile>();
+                    tLock lock(m_Access);
+                    m_Profiles.push_back(profile);
+                    state.profile = std::move(profile);
+                }
+                catch (...)
+                {
+                    return nullptr;
+                }
+            }
+
+            return state.profile.get();
+        }
+
+    private:
+        std::atomic<std::uint32_t> m_SamplingPeriod { DefaultSamplingPeriod };
+        std::vector<tThreadProfilePtr> m_Profiles;
+        std::mutex mutable m_Access;
+    };
+
+    TaskProfiler::TaskProfiler()
+        : m_Impl(std::make_unique<_Impl>())
+    {
+    }
+
+    TaskProfiler::~TaskProfiler() = default;
+
+    /// @short Is never destroyed: queue workers may still finish their tasks while the statics are destroyed.
+    TaskProfiler& TaskProfiler::Instance()
+    {
+        static TaskProfiler* const instance = new TaskProfiler();
+        return *instance;
+    }
+
+    void TaskProfiler::Enable(bool isEnabled) noexcept
+    {
+        m_IsEnabled.store(isEnabled, std::memory_order_relaxed);
+    }
+
+    void TaskProfiler::SetSamplingPeriod(std::uint32_t period) noexcept
+    {
+        m_Impl->_SetSamplingPeriod(period);
+    }
+
+    std::uint32_t TaskProfiler::GetSamplingPeriod() const noexcept
+    {
+        return m_Impl->_GetSamplingPeriod();
+    }
+
+    TaskProfiler::Sample TaskProfiler::StartSample() noexcept
+    {
+        Sample sample;
+        if (IsEnabled())
+        {
+            sample.m_Weight = m_Impl->_TakeSampleTurn();
+        }
+
+        if (sample.m_Weight != 0)
+        {
+            sample.m_WallStart = std::chrono::steady_clock::now();
+            sample.m_CpuStart = GetThreadCpuTime();
+        }
+
+        return sample;
+    }
+
+    void TaskProfiler::FinishSample(Sample const& sample, std::source_location const& location) noexcept
+    {
+        if (sample.m_Weight != 0)
+        {
+            auto const cpuTime = GetThreadCpuTime() - sample.m_CpuStart;
+            auto const wallTime = std::chrono::steady_clock::now() - sample.m_WallStart;
+            m_Impl->_Account(location, cpuTime, std::chrono::duration_cast<std::chrono::nanoseconds>(wallTime)
+                             , sample.m_Weight);
+        }
+    }
+
+    TaskProfiler::tReport TaskProfiler::GetReport() const
+    {
+        return m_Impl->_GetReport();
+    }
+
+    void TaskProfiler::WriteReport(std::ostream& stream, std::size_t maxCount) const
+    {
+        auto const report = GetReport();
+
+        auto const toMicroseconds = [](std::chrono::nanoseconds duration) {
+            return std::chrono::duration<double, std::micro>(duration).count();
+        };
+
+        std::ios::fmtflags const flags = stream.flags();
+        std::streamsize const precision = stream.precision();
+
+        stream << std::left << std::setw(14) << "cpu, us" << std::setw(14) << "wall, us" << std::setw(12) << "count"
+               << std::setw(12) << "max, us" << "site" << '\n';
+        for (std::size_t index = 0; index < std::min(maxCount, report.size()); ++index)
+        {
+            TaskSiteStatistics const& site = report[index];
+            stream << std::left << std::fixed << std::setprecision(1)
+                   << std::setw(14) << toMicroseconds(site.estimatedCpuTime)
+                   << std::setw(14) << toMicroseconds(site.estimatedWallTime)
+                   << std::setw(12) << site.estimatedCount
+                   << std::setw(12) << toMicroseconds(site.maxWallTime)
+                   << site.fileName << ':' << site.line << ' ' << site.functionName << '\n';
+        }
+
+        stream.flags(flags);
+        stream.precision(precision);
+    }
+
+    void TaskProfiler::Reset()
+    {
+        m_Impl->_Reset();
+    }
+} /// end namespace Darkness::Concurrency
@@ -0,0 +1,128 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    ThreadAttributes.cpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Implementation of SetCurrentThreadAttributes
+
+#include <Darkness/Concurrency/ThreadAttributes.hpp>
+
+#if defined(_WIN32)
+
+#include <Windows.h>
+#include <processthreadsapi.h>
+
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#error Unknown OS!
+#endif
+
+namespace Darkness::Concurrency {
+    namespace {
+#if defined(_WIN32)
+        inline namespace _win {
+            bool _SetCpuSet(tCpuSet const& cpuSet) noexcept
+            {
+                DWORD_PTR mask = 0;
+                for (std::size_t const cpu : cpuSet)
+                {
+                    if (cpu < sizeof(DWORD_PTR) * 8)
+                    {
+                        mask |= DWORD_PTR(1) << cpu;
+                    }
+                }
+
+                return mask != 0 && ::SetThreadAffinityMask(::GetCurrentThread(), mask) != 0;
+            }
+
+            /// @short Windows has no per-thread scheduling classes and nice values, they are mapped onto the
+            ///        thread priority.
+            bool _SetScheduling(eSchedulingPolicy policy, [[maybe_unused]] int priority) noexcept
+            {
+                int const threadPriority = policy == eSchedulingPolicy::Fifo ? THREAD_PRIORITY_TIME_CRITICAL
+                                                                             : THREAD_PRIORITY_NORMAL;
+                return ::SetThreadPriority(::GetCurrentThread(), threadPriority) != 0;
+            }
+
+            bool _SetNice(int nice) noexcept
+            {
+                int const threadPriority = nice < -10 ? THREAD_PRIORITY_HIGHEST
+                                           : nice < 0 ? THREAD_PRIORITY_ABOVE_NORMAL
+                                           : nice == 0 ? THREAD_PRIORITY_NORMAL
+                                           : nice <= 10 ? THREAD_PRIORITY_BELOW_NORMAL
+                                           : THREAD_PRIORITY_LOWEST;
+                return ::SetThreadPriority(::GetCurrentThread(), threadPriority) != 0;
+            }
+        } /// end inline namespace _win
+
+        namespace _os = _win;
+#elif defined(__linux__)
+        inline namespace _linux {
+            bool _SetCpuSet(tCpuSet const& cpuSet) noexcept
+            {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                bool isAnySet = false;
+                for (std::size_t const cpu : cpuSet)
+                {
+                    if (cpu < CPU_SETSIZE)
+                    {
+                        CPU_SET(cpu, &set);
+                        isAnySet = true;
+                    }
+                }
+
+                return isAnySet && pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+            }
+
+            bool _SetScheduling(eSchedulingPolicy policy, int priority) noexcept
+            {
+                sched_param parameters {};
+                parameters.sched_priority = policy == eSchedulingPolicy::Fifo ? priority : 0;
+                return pthread_setschedparam(pthread_self(), policy == eSchedulingPolicy::Fifo ? SCHED_FIFO
+                                                                                               : SCHED_OTHER
+                                             , &parameters) == 0;
+            }
+
+            /// @short On Linux the nice value belongs to the thread, it is addressed by the thread id.
+            bool _SetNice(int nice) noexcept
+            {
+                auto const threadId = static_cast<id_t>(::syscall(SYS_gettid));
+                return ::setpriority(PRIO_PROCESS, threadId, nice) == 0;
+            }
+        } /// end inline namespace _linux
+
+        namespace _os = _linux;
+#else
+#error Unknown OS!
+#endif
+    } /// end unnamed namespace
+
+    bool SetCurrentThreadAttributes(ThreadAttributes const& attributes) noexcept
+    {
+        bool isApplied = true;
+        if (!attributes.cpuSet.empty())
+        {
+            isApplied = _os::_SetCpuSet(attributes.cpuSet) && isApplied;
+        }
+
+        if (attributes.schedulingPolicy != eSchedulingPolicy::Inherit)
+        {
+            isApplied = _os::_SetScheduling(attributes.schedulingPolicy, attributes.priority) && isApplied;
+        }
+
+        if (attributes.nice)
+        {
+            isApplied = _os::_SetNice(*attributes.nice) && isApplied;
+        }
+
+        return isApplied;
+    }
+} /// end namespace Darkness::Concurrency
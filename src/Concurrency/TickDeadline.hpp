@@ -0,0 +1,52 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    TickDeadline.hpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Calculation of deadlines of fixed-rate timers.
+
+#pragma once
+
+#include <Darkness/Concurrency/Types.hpp>
+
+#include <chrono>
+
+namespace Darkness::Concurrency {
+    /// @brief Moves the grid of a fixed-rate timer by one period and returns the deadline of the next tick.
+    /// @param grid The aligned deadline of the previous tick. Is updated.
+    /// @short The returned deadline may be in the past (CatchUp and Coalesce), then the tick should run at once.
+    template<typename ClockT, typename DurationT>
+    [[nodiscard]] typename ClockT::time_point NextTickDeadline(typename ClockT::time_point& grid, DurationT period
+                                                               , eMissedTickPolicy missedTickPolicy
+                                                               , typename ClockT::time_point now)
+    {
+        if (period <= DurationT::zero())
+        {
+            return grid = now;
+        }
+
+        grid += period;
+        if (grid >= now)
+        {
+            return grid;
+        }
+
+        switch (missedTickPolicy)
+        {
+            case eMissedTickPolicy::Skip:
+                grid += ((now - grid) / period + 1) * period;
+                break;
+
+            case eMissedTickPolicy::CatchUp:
+                break;
+
+            case eMissedTickPolicy::Coalesce:
+                grid += ((now - grid) / period) * period;
+                break;
+        }
+
+        return grid;
+    }
+} /// end namespace Darkness::Concurrency
@@ -0,0 +1,62 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    TicketLock.cpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Implementation of @class TicketLock
+
+#include "Darkness/Concurrency/TicketLock.hpp"
+#include "Darkness/Concurrency/Utilities.hpp"
+
+namespace Darkness::Concurrency {
+    TicketLock::TicketLock() noexcept = default;
+
+    void TicketLock::lock() noexcept
+    {
+        tTicket const ticket = m_NextTicket.fetch_add(1, std::memory_order_relaxed);
+        std::atomic<tTicket>& grant = m_Slots[ticket % _SlotsCount].grant;
+
+        for (std::uint32_t round = 0; round < _SpinRounds; ++round)
+        {
+            if (grant.load(std::memory_order_acquire) == ticket)
+            {
+                return;
+            }
+
+            CpuRelax();
+        }
+
+        m_ParkedCount.fetch_add(1, std::memory_order_seq_cst);
+        for (tTicket granted = grant.load(std::memory_order_seq_cst); granted != ticket
+             ; granted = grant.load(std::memory_order_seq_cst))
+        {
+            grant.wait(granted, std::memory_order_seq_cst);
+        }
+
+        m_ParkedCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    bool TicketLock::try_lock() noexcept
+    {
+        tTicket expected = m_ServedTicket.load(std::memory_order_acquire);
+        return m_NextTicket.compare_exchange_strong(expected, expected + 1, std::memory_order_acquire
+                                                    , std::memory_order_relaxed);
+    }
+
+    void TicketLock::unlock() noexcept
+    {
+        /// @short Only the owner writes the served ticket, so the plain increment is safe.
+        tTicket const next = m_ServedTicket.load(std::memory_order_relaxed) + 1;
+        m_ServedTicket.store(next, std::memory_order_release);
+
+        std::atomic<tTicket>& grant = m_Slots[next % _SlotsCount].grant;
+        grant.store(next, std::memory_order_seq_cst);
+
+        if (m_ParkedCount.load(std::memory_order_seq_cst) != 0)
+        {
+            grant.notify_all();
+        }
+    }
+} /// namespace Darkness::Concurrency
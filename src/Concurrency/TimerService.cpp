@@ -0,0 +1,521 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    TimerService.cpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Implementation of @class TimerService
+
+#include <Darkness/Concurrency/TimerService.hpp>
+#include <Darkness/Concurrency/Utilities.hpp>
+#include "TickDeadline.hpp"
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Darkness::Concurrency {
+    class TimerService::_Impl final
+    {
+        using tClock = std::chrono::steady_clock;
+        using tTick = std::uint64_t;
+        using tUniqueLock = std::unique_lock<std::mutex>;
+
+        static constexpr std::size_t const _LevelsCount = 4;
+        static constexpr std::size_t const _SlotBits = 8;
+        static constexpr std::size_t const _SlotsCount = std::size_t(1) << _SlotBits;
+        static constexpr tTick const _SlotMask = _SlotsCount - 1;
+        static constexpr tTick const _MaxDelta = (tTick(1) << (_SlotBits * _LevelsCount)) - 1;
+
+        /// @short Intrusive node of a circular list of a wheel slot.
+        struct _Link
+        {
+            _Link* prev { this };
+            _Link* next { this };
+
+            [[nodiscard]] bool _IsLinked() const noexcept
+            {
+                return next != this;
+            }
+
+            void _Unlink() noexcept
+            {
+                prev->next = next;
+                next->prev = prev;
+                prev = next = this;
+            }
+
+            void _PushBack(_Link* link) noexcept
+            {
+                link->prev = prev;
+                link->next = this;
+                prev->next = link;
+                prev = link;
+            }
+        };
+
+        struct _Timer final : _Link
+        {
+            tTimerId id { InvalidTimerId };
+            tTick expiry { 0 };
+            tDelayProvider delayProvider;
+            eTimerMode mode { eTimerMode::FixedDelay };
+            eMissedTickPolicy missedTickPolicy { eMissedTickPolicy::Skip };
+            tClock::time_point grid {};
+            tTask task;
+            tQueueWeakPtr queue;
+            bool isDispatched { false };
+            tExceptionHandler exceptionHandler;
+            std::atomic<bool> cancelled { false };
+            std::atomic<bool> pending { false };
+            std::atomic<std::uint32_t> running { 0 };
+            std::atomic<std::thread::id> runner {};
+        };
+
+        using tTimerPtr = std::shared_ptr<_Timer>;
+
+        /// @brief Is held by the posted execution. Clears the pending flag when the execution is destroyed,
+        ///        whether it is run or dropped by the queue.
+        class _PendingGuard final
+        {
+        public:
+            explicit _PendingGuard(tTimerPtr timer) noexcept
+                : m_Timer(std::move(timer))
+            {
+            }
+
+            _PendingGuard(_PendingGuard&&) noexcept = default;
+            _PendingGuard& operator=(_PendingGuard&&) = delete;
+
+            ~_PendingGuard()
+            {
+                if (m_Timer)
+                {
+                    m_Timer->pending = false;
+                }
+            }
+
+            [[nodiscard]] _Timer& _GetTimer() const noexcept
+            {
+                return *m_Timer;
+            }
+
+        private:
+            tTimerPtr m_Timer;
+        };
+
+        using tTimers = std::unordered_map<tTimerId, tTimerPtr>;
+        using tSlots = std::array<_Link, _SlotsCount>;
+        using tWheel = std::array<tSlots, _LevelsCount>;
+
+    public:
+        explicit _Impl(std::string name, tDuration resolution)
+            : m_Name(std::move(name))
+              , m_Resolution(resolution)
+              , m_Origin(tClock::now())
+        {
+            if (m_Resolution <= tDuration::zero())
+            {
+                throw std::invalid_argument(
+                    "Darkness::Concurrency::TimerService::_Impl::ctor: resolution should be positive!");
+            }
+
+            m_Thread = std::jthread([this](std::stop_token stopToken) { _Routine(std::move(stopToken)); });
+        }
+
+        ~_Impl()
+        {
+            {
+                tUniqueLock const lock(m_Mutex);
+                m_Thread.request_stop();
+            }
+
+            m_Condition.notify_all();
+            m_Thread = {};
+
+            for (auto& [id, timer] : m_Timers)
+            {
+                timer->_Unlink();
+                timer->cancelled = true;
+            }
+        }
+
+        tTimerId _Schedule(tDuration firstDelay, tDelayProvider delayProvider, tTask task
+                           , tQueueWeakPtr queue, tExceptionHandler exceptionHandler
+                           , eTimerMode mode, eMissedTickPolicy missedTickPolicy)
+        {
+            auto timer = std::make_shared<_Timer>();
+            timer->delayProvider = std::move(delayProvider);
+            timer->mode = mode;
+            timer->missedTickPolicy = missedTickPolicy;
+            timer->task = std::move(task);
+            /// @short An expired queue is distinguished from the absent one, the task is not run inline for it.
+            timer->isDispatched = queue.owner_before(tQueueWeakPtr {}) || tQueueWeakPtr {}.owner_before(queue);
+            timer->queue = std::move(queue);
+            timer->exceptionHandler = std::move(exceptionHandler);
+
+            bool isWakeUpNeeded = false;
+            {
+                tUniqueLock const lock(m_Mutex);
+                if (m_Timers.empty())
+                {
+                    /// @short The idle wheel is moved to the current time at once instead of tick by tick.
+                    m_CurrentTick = std::max(m_CurrentTick, _ToTick(tClock::now()));
+                }
+
+                timer->id = ++m_LastId;
+                timer->grid = tClock::now() + firstDelay;
+                timer->expiry = _ToExpiryTick(timer->grid);
+                _Insert(timer.get());
+                isWakeUpNeeded = timer->expiry < m_WakeUpTick;
+                m_Timers.emplace(timer->id, timer);
+            }
+
+            if (isWakeUpNeeded)
+            {
+                m_Condition.notify_one();
+            }
+
+            return timer->id;
+        }
+
+        bool _Cancel(tTimerId id)
+        {
+            tTimerPtr timer;
+            {
+                tUniqueLock const lock(m_Mutex);
+                auto found = m_Timers.find(id);
+                if (found == m_Timers.end())
+                {
+                    return false;
+                }
+
+                timer = std::move(found->second);
+                m_Timers.erase(found);
+                timer->_Unlink();
+                timer->cancelled = true;
+            }
+
+            /// @short Pairs with _Execute: either the task sees the cancellation or we see it running.
+            if (timer->runner.load() != std::this_thread::get_id())
+            {
+                for (auto running = timer->running.load(); running != 0; running = timer->running.load())
+                {
+                    timer->running.wait(running);
+                }
+            }
+
+            return true;
+        }
+
+        [[nodiscard]] std::size_t _GetTimersCount() const
+        {
+            tUniqueLock const lock(m_Mutex);
+            return m_Timers.size();
+        }
+
+    private:
+        void _Routine(std::stop_token stopToken) noexcept
+        {
+            if (!m_Name.empty())
+            {
+                SetCurrentThreadName(m_Name);
+            }
+
+            std::vector<tTimerPtr> expired;
+            std::vector<tClock::time_point> deadlines;
+
+            tUniqueLock lock(m_Mutex);
+            while (!stopToken.stop_requested())
+            {
+                if (m_Timers.empty())
+                {
+                    m_WakeUpTick = std::numeric_limits<tTick>::max();
+                    m_Condition.wait(lock, [this, &stopToken] {
+                        return stopToken.stop_requested() || !m_Timers.empty();
+                    });
+
+                    continue;
+                }
+
+                tTick const nowTick = _ToTick(tClock::now());
+                while (m_CurrentTick < nowTick)
+                {
+                    _Advance(expired);
+                }
+
+                if (!expired.empty())
+                {
+                    lock.unlock();
+                    for (auto const& timer : expired)
+                    {
+                        _Fire(timer);
+                    }
+
+                    _GetNextDeadlines(expired, deadlines);
+
+                    lock.lock();
+                    _Reschedule(expired, deadlines);
+                    expired.clear();
+                    deadlines.clear();
+                    continue;
+                }
+
+                m_WakeUpTick = _GetWakeUpTick();
+                m_Condition.wait_until(lock, m_Origin + m_WakeUpTick * m_Resolution);
+            }
+        }
+
+        /// @brief Moves the wheel by one tick. Cascades the higher levels when the lower ones wrap around.
+        void _Advance(std::vector<tTimerPtr>& expired)
+        {
+            ++m_CurrentTick;
+
+            for (std::size_t level = _LevelsCount - 1; level != 0; --level)
+            {
+                if ((m_CurrentTick & ((tTick(1) << (_SlotBits * level)) - 1)) == 0)
+                {
+                    _Link& slot = m_Wheel[level][(m_CurrentTick >> (_SlotBits * level)) & _SlotMask];
+                    while (slot._IsLinked())
+                    {
+                        auto* const timer = static_cast<_Timer*>(slot.next);
+                        timer->_Unlink();
+                        _Insert(timer);
+                    }
+                }
+            }
+
+            _Link& slot = m_Wheel[0][m_CurrentTick & _SlotMask];
+            while (slot._IsLinked())
+            {
+                auto* const timer = static_cast<_Timer*>(slot.next);
+                timer->_Unlink();
+                expired.push_back(m_Timers.at(timer->id));
+            }
+        }
+
+        void _Insert(_Timer* timer) noexcept
+        {
+            assert(!timer->_IsLinked() && "Bad logic!");
+
+            timer->expiry = std::max(timer->expiry, m_CurrentTick);
+            tTick const delta = std::min(timer->expiry - m_CurrentTick, _MaxDelta);
+            tTick const slotTick = m_CurrentTick + delta;
+
+            std::size_t level = 0;
+            while (level + 1 < _LevelsCount && delta >= (tTick(1) << (_SlotBits * (level + 1))))
+            {
+                ++level;
+            }
+
+            m_Wheel[level][(slotTick >> (_SlotBits * level)) & _SlotMask]._PushBack(timer);
+        }
+
+        void _Fire(tTimerPtr const& timer)
+        {
+            if (timer->cancelled)
+            {
+                return;
+            }
+
+            if (!timer->isDispatched)
+            {
+                _Execute(*timer);
+                return;
+            }
+
+            /// @short The next tick is skipped while the posted execution is not finished.
+            if (timer->pending.exchange(true))
+            {
+                return;
+            }
+
+            if (auto const queue = timer->queue.lock())
+            {
+                queue->Post([guard = _PendingGuard(timer)] { _Execute(guard._GetTimer()); });
+            }
+            else
+            {
+                timer->pending = false;
+            }
+        }
+
+        static void _Execute(_Timer& timer) noexcept
+        {
+            timer.running.fetch_add(1);
+            if (!timer.cancelled.load())
+            {
+                timer.runner = std::this_thread::get_id();
+                try
+                {
+                    timer.task();
+                }
+                catch (...)
+                {
+                    auto const exceptionPtr = std::current_exception();
+#if defined(Darkness_Concurrency_Timer_DEBUG)
+                    DebugExceptionHandler(exceptionPtr);
+#endif /// Darkness_Concurrency_Timer_DEBUG
+                    if (timer.exceptionHandler)
+                    {
+                        try
+                        {
+                            timer.exceptionHandler(exceptionPtr);
+                        }
+                        catch (...)
+                        {
+                        }
+                    }
+                }
+
+                timer.runner = std::thread::id {};
+            }
+
+            if (timer.running.fetch_sub(1) == 1)
+            {
+                timer.running.notify_all();
+            }
+        }
+
+        /// @brief Asks the delay providers of the periodic timers for the next deadlines.
+        /// @short Is called without the lock, so a provider may schedule or cancel timers. The provider and the grid
+        ///        are used only by the service thread after the timer is scheduled.
+        static void _GetNextDeadlines(std::vector<tTimerPtr> const& expired
+                                      , std::vector<tClock::time_point>& deadlines)
+        {
+            deadlines.reserve(expired.size());
+            for (auto const& timer : expired)
+            {
+                if (timer->cancelled || !timer->delayProvider)
+                {
+                    deadlines.emplace_back();
+                    continue;
+                }
+
+                auto const delay = timer->delayProvider();
+                auto const now = tClock::now();
+                deadlines.push_back(timer->mode == eTimerMode::FixedRate
+                                    ? NextTickDeadline<tClock>(timer->grid, delay, timer->missedTickPolicy, now)
+                                    : now + delay);
+            }
+        }
+
+        void _Reschedule(std::vector<tTimerPtr> const& expired, std::vector<tClock::time_point> const& deadlines)
+        {
+            for (std::size_t index = 0; index < expired.size(); ++index)
+            {
+                auto const& timer = expired[index];
+                if (timer->cancelled)
+                {
+                    continue;
+                }
+
+                if (!timer->delayProvider)
+                {
+                    m_Timers.erase(timer->id);
+                    continue;
+                }
+
+                timer->expiry = _ToExpiryTick(deadlines[index]);
+                _Insert(timer.get());
+            }
+        }
+
+        /// @brief Returns the tick of the nearest non-empty slot of the first level, or the end of its rotation
+        ///        where the higher levels should be cascaded.
+        [[nodiscard]] tTick _GetWakeUpTick() const noexcept
+        {
+            tTick tick = m_CurrentTick + 1;
+            for (; (tick & _SlotMask) != 0; ++tick)
+            {
+                if (m_Wheel[0][tick & _SlotMask]._IsLinked())
+                {
+                    return tick;
+                }
+            }
+
+            return tick;
+        }
+
+        [[nodiscard]] tTick _ToTick(tClock::time_point timePoint) const noexcept
+        {
+            return tTick((timePoint - m_Origin) / m_Resolution);
+        }
+
+        /// @short The timer never fires earlier than requested, so the expiry tick is rounded up.
+        [[nodiscard]] tTick _ToExpiryTick(tClock::time_point timePoint) const noexcept
+        {
+            auto const sinceOrigin = std::max(timePoint - m_Origin, tClock::duration::zero());
+            tTick const tick = tTick((sinceOrigin + m_Resolution - tDuration(1)) / m_Resolution);
+            return std::max(tick, m_CurrentTick + 1);
+        }
+
+    private:
+        std::string const m_Name;
+        tDuration const m_Resolution;
+        tClock::time_point const m_Origin;
+        tWheel m_Wheel {};
+        tTimers m_Timers;
+        tTick m_CurrentTick { 0 };
+        tTick m_WakeUpTick { std::numeric_limits<tTick>::max() };
+        tTimerId m_LastId { InvalidTimerId };
+        std::mutex mutable m_Mutex;
+        std::condition_variable m_Condition;
+        std::jthread m_Thread;
+    };
+
+    TimerService::TimerService(std::string name, tDuration resolution)
+        : m_Impl(std::make_unique<_Impl>(std::move(name), resolution))
+    {
+    }
+
+    TimerService::~TimerService() = default;
+
+    std::shared_ptr<TimerService> const& TimerService::Instance()
+    {
+        static auto const instance = std::make_shared<TimerService>("Darkness.Timers");
+        return instance;
+    }
+
+    TimerService::tTimerId TimerService::SchedulePeriodic(tDelayProvider delayProvider, tTask task
+                                                          , tQueueWeakPtr queue, tExceptionHandler exceptionHandler
+                                                          , eTimerMode mode, eMissedTickPolicy missedTickPolicy)
+    {
+        assert(delayProvider && "Bad data!");
+        if (!delayProvider)
+        {
+            throw std::invalid_argument(
+                "Darkness::Concurrency::TimerService::SchedulePeriodic: delayProvider is invalid!");
+        }
+
+        auto const firstDelay = delayProvider();
+        return _Schedule(firstDelay, std::move(delayProvider), std::move(task), std::move(queue)
+                         , std::move(exceptionHandler), mode, missedTickPolicy);
+    }
+
+    bool TimerService::Cancel(tTimerId id)
+    {
+        return m_Impl->_Cancel(id);
+    }
+
+    std::size_t TimerService::GetTimersCount() const
+    {
+        return m_Impl->_GetTimersCount();
+    }
+
+    TimerService::tTimerId TimerService::_Schedule(tDuration firstDelay, tDelayProvider delayProvider, tTask task
+                                                   , tQueueWeakPtr queue, tExceptionHandler exceptionHandler
+                                                   , eTimerMode mode, eMissedTickPolicy missedTickPolicy)
+    {
+        return m_Impl->_Schedule(firstDelay, std::move(delayProvider), std::move(task), std::move(queue)
+                                 , std::move(exceptionHandler), mode, missedTickPolicy);
+    }
+} /// namespace Darkness::Concurrency
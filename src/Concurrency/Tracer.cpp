@@ -0,0 +1,523 @@
+/// Project          Darkness. C++ library.
+/// Copyright (c)    2025 Poturaiev Anton. All rights reserved.
+///
+/// @file    Tracer.cpp
+/// @authors Poturaiev Anton
+/// @license Distributed under the Boost Software License, Version 1.0.
+///		     See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+/// @brief   Implementation of @class Tracer
+
+#include <Darkness/Concurrency/Tracer.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Darkness::Concurrency {
+    namespace {
+        using tClock = std::chrono::steady_clock;
+
+        constexpr std::size_t const DefaultThreadBufferCapacity = std::size_t(1) << 15;
+
+        enum class eEventType : std::uint8_t
+        {
+            Post,
+            Begin,
+            End,
+            Instant
+        };
+
+        /// @short The fields are atomic because the dump reads them while the owner thread may overwrite them.
+        ///        Relaxed stores cost the same as plain ones.
+        struct Event final
+        {
+            std::atomic<std::uint64_t> timestamp { 0 };
+            std::atomic<std::uint64_t> flowId { 0 };
+            std::atomic<Tracer::tNameId> nameId { 0 };
+            std::atomic<eEventType> type { eEventType::Instant };
+            std::atomic<eTraceCategory> category { eTraceCategory::User };
+        };
+
+        struct EventCopy final
+        {
+            std::uint64_t timestamp;
+            std::uint64_t flowId;
+            Tracer::tNameId nameId;
+            eEventType type;
+            eTraceCategory category;
+        };
+
+        /// @brief The ring of events of one thread. Only the owner thread writes into it.
+        struct ThreadBuffer final
+        {
+            ThreadBuffer(std::size_t capacity, std::uint32_t index)
+                : events(new Event[capacity])
+                  , capacity(capacity)
+                  , index(index)
+            {
+            }
+
+            /// @brief Copies the events which are not overwritten during the copy.
+            void CopyTo(std::vector<EventCopy>& copies) const
+            {
+                std::uint64_t const head = this->head.load(std::memory_order_acquire);
+                std::uint64_t const begin = std::max(first.load(std::memory_order_acquire)
+                                                     , head > capacity ? head - capacity : 0);
+                copies.clear();
+                copies.reserve(head - std::min(head, begin));
+                for (std::uint64_t position = begin; position < head; ++position)
+                {
+                    Event const& event = events[position & (capacity - 1)];
+                    copies.push_back({ event.timestamp.load(std::memory_order_relaxed)
+                                       , event.flowId.load(std::memory_order_relaxed)
+                                       , event.nameId.load(std::memory_order_relaxed)
+                                       , event.type.load(std::memory_order_relaxed)
+                                       , event.category.load(std::memory_order_relaxed) });
+                }
+
+                /// @short The owner may be writing the event at the current head, it takes the slot of the event
+                ///        which is capacity positions older.
+                std::atomic_thread_fence(std::memory_order_acquire);
+                std::uint64_t const currentHead = this->head.load(std::memory_order_relaxed);
+                std::uint64_t const valid = currentHead >= capacity ? currentHead - capacity + 1 : 0;
+                if (valid > begin)
+                {
+                    copies.erase(copies.begin()
+                                 , copies.begin() + std::ptrdiff_t(std::min<std::uint64_t>(valid - begin
+                                                                                           , copies.size())));
+                }
+            }
+
+            std::unique_ptr<Event[]> const events;
+            std::uint64_t const capacity;
+            std::uint32_t const index;
+            std::atomic<std::uint64_t> head { 0 };
+
+            /// @brief The events before are cleared.
+            std::atomic<std::uint64_t> first { 0 };
+
+            std::atomic<bool> isFinished { false };
+
+            /// @brief Is guarded by the lock of the tracer.
+            std::string name;
+        };
+
+        using tThreadBufferPtr = std::shared_ptr<ThreadBuffer>;
+
+        void WriteJsonString(std::ostream& stream, std::string_view value)
+        {
+            static constexpr char const* const hexDigits = "0123456789abcdef";
+
+            stream << '"';
+            for (char const character : value)
+            {
+                switch (character)
+                {
+                    case '"':
+                        stream << "\\\"";
+                        break;
+
+                    case '\\':
+                        stream << "\\\\";
+                        break;
+
+                    default:
+                        if (static_cast<unsigned char>(character) < 0x20)
+                        {
+                            stream << "\\u00" << hexDigits[character >> 4] << hexDigits[character & 0xF];
+                        }
+                        else
+                        {
+                            stream << character;
+                        }
+                        break;
+                }
+            }
+
+            stream << '"';
+        }
+
+        /// @brief Writes nanoseconds as microseconds with three decimals, the unit of the trace-event format.
+        void WriteTimestamp(std::ostream& stream, std::uint64_t nanoseconds)
+        {
+            auto const fraction = nanoseconds % 1000;
+            stream << nanoseconds / 1000 << '.' << char('0' + fraction / 100) << char('0' + fraction / 10 % 10)
+                   << char('0' + fraction % 10);
+        }
+
+        [[nodiscard]] std::string_view GetCategoryName(eTraceCategory category) noexcept
+        {
+            switch (category)
+            {
+                case eTraceCategory::Queue:
+                    return "queue";
+
+                case eTraceCategory::Timer:
+                    return "timer";
+
+                case eTraceCategory::Scheduler:
+                    return "scheduler";
+
+                case eTraceCategory::User:
+                    break;
+            }
+
+            return "user";
+        }
+    } /// end unnamed namespace
+
+    class Tracer::_Impl final
+    {
+        /// @brief The state of the current thread. Marks its ring as finished on the thread exit, the ring is kept
+        ///        by the tracer till Clear for the dump.
+        struct _ThreadState final
+        {
+            ~_ThreadState()
+            {
+                if (buffer)
+                {
+                    buffer->isFinished.store(true, std::memory_order_release);
+                }
+            }
+
+            tThreadBufferPtr buffer;
+            std::string name;
+            std::uint32_t flowsCount { 0 };
+        };
+
+        /// @short Allows lookup by std::string_view without construction of std::string.
+        struct _NameHash final
+        {
+            using is_transparent = void;
+
+            [[nodiscard]] std::size_t operator()(std::string_view name) const noexcept
+            {
+                return std::hash<std::string_view> {}(name);
+            }
+        };
+
+        using tNameIds = std::unordered_map<std::string, tNameId, _NameHash, std::equal_to<>>;
+        using tLock = std::lock_guard<std::mutex> const;
+
+    public:
+        _Impl()
+            : m_Epoch(tClock::now())
+        {
+        }
+
+        void _SetThreadBufferCapacity(std::size_t eventsCount) noexcept
+        {
+            m_Capacity.store(std::bit_ceil(std::max<std::size_t>(eventsCount, 2)), std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] tNameId _Intern(std::string_view name)
+        {
+            tLock lock(m_Access);
+            auto found = m_NameIds.find(name);
+            if (found == m_NameIds.end())
+            {
+                found = m_NameIds.emplace(std::string(name), tNameId(m_Names.size())).first;
+                m_Names.emplace_back(name);
+            }
+
+            return found->second;
+        }
+
+        void _SetCurrentThreadName(std::string_view name)
+        {
+            _ThreadState& state = _GetThreadState();
+            state.name = name;
+            if (state.buffer)
+            {
+                tLock lock(m_Access);
+                state.buffer->name = state.name;
+            }
+        }
+
+        [[nodiscard]] tFlowId _NextFlowId() noexcept
+        {
+            _ThreadState& state = _GetThreadState();
+            if (!_GetCurrentThreadBuffer())
+            {
+                return NoFlowId;
+            }
+
+            /// @short Unique without a shared counter: the index of the thread ring and the count of its flows.
+            return (tFlowId(state.buffer->index + 1) << 32) | ++state.flowsCount;
+        }
+
+        void _Record(eEventType type, tNameId nameId, eTraceCategory category, tFlowId flowId) noexcept
+        {
+            ThreadBuffer* const buffer = _GetCurrentThreadBuffer();
+            if (!buffer)
+            {
+                return;
+            }
+
+            std::uint64_t const position = buffer->head.load(std::memory_order_relaxed);
+            Event& event = buffer->events[position & (buffer->capacity - 1)];
+
+            /// @short Pairs with the acquire fence of CopyTo, as in a seqlock: if the dump sees any field of this
+            ///        event, it also sees the head which has published the previous one, so it drops the event
+            ///        which is overwritten here. Is free on x86.
+            std::atomic_thread_fence(std::memory_order_release);
+            event.timestamp.store(std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                tClock::now() - m_Epoch).count()), std::memory_order_relaxed);
+            event.flowId.store(flowId, std::memory_order_relaxed);
+            event.nameId.store(nameId, std::memory_order_relaxed);
+            event.type.store(type, std::memory_order_relaxed);
+            event.category.store(category, std::memory_order_relaxed);
+            buffer->head.store(position + 1, std::memory_order_release);
+        }
+
+        void _Clear()
+        {
+            tLock lock(m_Access);
+            std::erase_if(m_Buffers, [](tThreadBufferPtr const& buffer) {
+                return buffer->isFinished.load(std::memory_order_acquire);
+            });
+
+            for (auto const& buffer : m_Buffers)
+            {
+                buffer->first.store(buffer->head.load(std::memory_order_acquire), std::memory_order_release);
+            }
+        }
+
+        void _WriteChromeTrace(std::ostream& stream) const
+        {
+            std::vector<tThreadBufferPtr> buffers;
+            std::vector<std::string> threadNames;
+            std::vector<std::string> names;
+            {
+                tLock lock(m_Access);
+                buffers = m_Buffers;
+                for (auto const& buffer : buffers)
+                {
+                    threadNames.push_back(buffer->name);
+                }
+
+                names.assign(m_Names.begin(), m_Names.end());
+            }
+
+            bool isFirst = true;
+            auto const beginEvent = [&stream, &isFirst](std::string_view name, std::string_view category
+                                                        , char phase, std::uint32_t threadIndex) {
+                stream << (isFirst ? "\n" : ",\n") << "{\"name\":";
+                isFirst = false;
+                WriteJsonString(stream, name);
+                stream << ",\"cat\":\"" << category << "\",\"ph\":\"" << phase << "\",\"pid\":1,\"tid\":"
+                       << threadIndex;
+            };
+
+            stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+            std::vector<EventCopy> events;
+            for (std::size_t bufferIndex = 0; bufferIndex < buffers.size(); ++bufferIndex)
+            {
+                ThreadBuffer const& buffer = *buffers[bufferIndex];
+                std::string const& threadName = threadNames[bufferIndex];
+
+                beginEvent("thread_name", "__metadata", 'M', buffer.index);
+                stream << ",\"args\":{\"name\":";
+                WriteJsonString(stream, threadName.empty() ? "Thread " + std::to_string(buffer.index) : threadName);
+                stream << "}}";
+
+                buffer.CopyTo(events);
+                for (EventCopy const& event : events)
+                {
+                    std::string_view const name = event.nameId < names.size()
+                                                  ? std::string_view(names[event.nameId]) : std::string_view("?");
+                    std::string_view const category = GetCategoryName(event.category);
+                    auto const writeTail = [&stream, &event] {
+                        stream << ",\"ts\":";
+                        WriteTimestamp(stream, event.timestamp);
+                        stream << '}';
+                    };
+                    auto const writeFlow = [&](char phase) {
+                        beginEvent(name, "flow", phase, buffer.index);
+                        stream << ",\"id\":\"0x" << std::hex << event.flowId << std::dec << '"';
+                        if (phase == 'f')
+                        {
+                            stream << ",\"bp\":\"e\"";
+                        }
+
+                        writeTail();
+                    };
+
+                    switch (event.type)
+                    {
+                        case eEventType::Post:
+                            beginEvent(name, "post", 'i', buffer.index);
+                            stream << ",\"s\":\"t\"";
+                            writeTail();
+                            if (event.flowId != NoFlowId)
+                            {
+                                writeFlow('s');
+                            }
+                            break;
+
+                        case eEventType::Begin:
+                            beginEvent(name, category, 'B', buffer.index);
+                            writeTail();
+                            if (event.flowId != NoFlowId)
+                            {
+                                writeFlow('f');
+                            }
+                            break;
+
+                        case eEventType::End:
+                            beginEvent(name, category, 'E', buffer.index);
+                            writeTail();
+                            break;
+
+                        case eEventType::Instant:
+                            beginEvent(name, category, 'i', buffer.index);
+                            stream << ",\"s\":\"t\"";
+                            writeTail();
+                            break;
+                    }
+                }
+            }
+
+            stream << "\n]}\n";
+        }
+
+    private:
+        [[nodiscard]] static _ThreadState& _GetThreadState() noexcept
+        {
+            thread_local _ThreadState state;
+            return state;
+        }
+
+        /// @return nullptr if the ring can not be allocated.
+        [[nodiscard]] ThreadBuffer* _GetCurrentThreadBuffer() noexcept
+        {
+            _ThreadState& state = _GetThreadState();
+            if (!state.buffer)
+            {
+                try
+                {
+                    tLock lock(m_Access);
+                    state.buffer = std::make_shared<ThreadBuffer>(m_Capacity.load(std::memory_order_relaxed)
+                                                                  , m_NextThreadIndex++);
+                    state.buffer->name = state.name;
+                    m_Buffers.push_back(state.buffer);
+                }
+                catch (...)
+                {
+                    state.buffer.reset();
+                }
+            }
+
+            return state.buffer.get();
+        }
+
+    private:
+        tClock::time_point const m_Epoch;
+        std::atomic<std::size_t> m_Capacity { DefaultThreadBufferCapacity };
+        std::vector<tThreadBufferPtr> m_Buffers;
+        std::uint32_t m_NextThreadIndex { 1 };
+        tNameIds m_NameIds;
+        std::deque<std::string> m_Names;
+        std::mutex mutable m_Access;
+    };
+
+    Tracer::Tracer()
+        : m_Impl(std::make_unique<_Impl>())
+    {
+    }
+
+    Tracer::~Tracer() = default;
+
+    /// @short Is never destroyed: queues, timers and schedulers may still record while the statics and the
+    ///        thread-locals are destroyed.
+    Tracer& Tracer::Instance()
+    {
+        static Tracer* const instance = new Tracer();
+        return *instance;
+    }
+
+    void Tracer::Enable(bool isEnabled) noexcept
+    {
+        m_IsEnabled.store(isEnabled, std::memory_order_relaxed);
+    }
+
+    void Tracer::SetThreadBufferCapacity(std::size_t eventsCount) noexcept
+    {
+        m_Impl->_SetThreadBufferCapacity(eventsCount);
+    }
+
+    Tracer::tNameId Tracer::Intern(std::string_view name)
+    {
+        return m_Impl->_Intern(name);
+    }
+
+    void Tracer::SetCurrentThreadName(std::string_view name)
+    {
+        m_Impl->_SetCurrentThreadName(name);
+    }
+
+    Tracer::tFlowId Tracer::RecordPost(tNameId nameId, eTraceCategory category) noexcept
+    {
+        if (!IsEnabled())
+        {
+            return NoFlowId;
+        }
+
+        tFlowId const flowId = m_Impl->_NextFlowId();
+        m_Impl->_Record(eEventType::Post, nameId, category, flowId);
+        return flowId;
+    }
+
+    bool Tracer::RecordBegin(tNameId nameId, eTraceCategory category, tFlowId flowId) noexcept
+    {
+        if (!IsEnabled())
+        {
+            return false;
+        }
+
+        m_Impl->_Record(eEventType::Begin, nameId, category, flowId);
+        return true;
+    }
+
+    void Tracer::RecordEnd(tNameId nameId, eTraceCategory category) noexcept
+    {
+        m_Impl->_Record(eEventType::End, nameId, category, NoFlowId);
+    }
+
+    void Tracer::RecordInstant(tNameId nameId, eTraceCategory category) noexcept
+    {
+        if (IsEnabled())
+        {
+            m_Impl->_Record(eEventType::Instant, nameId, category, NoFlowId);
+        }
+    }
+
+    void Tracer::Clear()
+    {
+        m_Impl->_Clear();
+    }
+
+    void Tracer::WriteChromeTrace(std::ostream& stream) const
+    {
+        m_Impl->_WriteChromeTrace(stream);
+    }
+
+    bool Tracer::WriteChromeTrace(std::string const& path) const
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            return false;
+        }
+
+        WriteChromeTrace(file);
+        return static_cast<bool>(file.flush());
+    }
+} /// end namespace Darkness::Concurrency
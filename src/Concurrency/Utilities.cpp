@@ -8,6 +8,7 @@
 /// @brief   Implementation of some utilities for menage ThreadName
 
 #include <Darkness/Concurrency/Utilities.hpp>
+#include <Darkness/Concurrency/Tracer.hpp>
 #include "Darkness/Common/Utilities.hpp"
 
 #include <iostream>
@@ -70,6 +71,9 @@ namespace Darkness::Concurrency {
     void SetCurrentThreadName(std::string const& name)
     {
         SetThreadName(name, GetCurrentThreadHandle());
+#if defined(Darkness_Concurrency_TRACE)
+        Tracer::Instance().SetCurrentThreadName(name);
+#endif /// Darkness_Concurrency_TRACE
     }
 
     std::thread::native_handle_type GetCurrentThreadHandle()
@@ -100,7 +104,7 @@ namespace Darkness::Concurrency {
     {
         if (task)
         {
-            std::jthread([task = std::move(task)]() { task(); }).detach();
+            std::jthread([task = std::move(task)]() mutable { task(); }).detach();
         }
     }
 } /// namespace Darkness::Concurrency